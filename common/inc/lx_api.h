@@ -262,6 +262,15 @@ typedef unsigned long long                      ULONG64;
 #define LX_NAND_SECTOR_MAPPING_CACHE_SIZE           128         /* Minimum value of 8, all sizes must be a power of 2, unless direct
                                                                    mapping is defined, in which there is no power of 2 requirement.  */
 #endif
+#ifndef LX_NAND_EXTENDED_CACHE_SIZE
+#define LX_NAND_EXTENDED_CACHE_SIZE                 8           /* Maximum number of logical groups in the extended cache.  */
+#endif
+#ifndef LX_NAND_METADATA_DELTA_RECORDS
+#define LX_NAND_METADATA_DELTA_RECORDS              32          /* Maximum number of table updates held for one delta page.  */
+#endif
+#ifndef LX_NAND_ANCHOR_BLOCKS
+#define LX_NAND_ANCHOR_BLOCKS                       2           /* Number of blocks reserved at the start of the flash for the mount anchor.  */
+#endif
 #ifndef LX_NAND_ERASE_COUNT_WRITE_SIZE
 #define LX_NAND_ERASE_COUNT_WRITE_SIZE              (nand_flash -> lx_nand_flash_pages_per_block + 1)
 #endif
@@ -331,6 +340,8 @@ typedef unsigned long long                      ULONG64;
 #define LX_NAND_PAGE_TYPE_PAGE_MAPPING_TABLE        0x70000000u
 #define LX_NAND_PAGE_TYPE_BLOCK_STATUS_TABLE        0x80000000u
 #define LX_NAND_PAGE_TYPE_BLOCK_LINK                0x90000000u
+#define LX_NAND_PAGE_TYPE_METADATA_DELTA            0xA0000000u
+#define LX_NAND_PAGE_TYPE_ANCHOR                    0xB0000000u
 #define LX_NAND_PAGE_TYPE_USER_DATA_MASK            0x0FFFFFFFu
 #define LX_NAND_PAGE_TYPE_PAGE_NUMBER_MASK          0x000000FFu
 
@@ -348,6 +359,7 @@ typedef unsigned long long                      ULONG64;
 #define LX_NAND_BLOCK_STATUS_FREE                   0xFFFFu
 #define LX_NAND_BLOCK_STATUS_BAD                    0xFF00u
 #define LX_NAND_BLOCK_STATUS_ALLOCATED              0x8000u
+#define LX_NAND_BLOCK_STATUS_ANCHOR                 0x7F00u
 
 #define LX_NAND_BLOCK_LINK_MAIN_METADATA_OFFSET     0
 #define LX_NAND_BLOCK_LINK_BACKUP_METADATA_OFFSET   4
@@ -359,6 +371,42 @@ typedef unsigned long long                      ULONG64;
 
 #define LX_NAND_BLOCK_UNMAPPED                      0xFFFF
 
+
+/* Define the sector page list entry values. An entry holds the page of a logical sector in a block.  */
+
+#define LX_NAND_SECTOR_PAGE_RELEASED                0x8000u
+#define LX_NAND_SECTOR_PAGE_RESOLVED                0xFFFEu
+#define LX_NAND_SECTOR_PAGE_NOT_FOUND               0xFFFFu
+
+
+/* Define the number of words in the dirty page bitmaps of the block status and erase count tables,
+   one bit for each table page that can be indexed in the metadata page type.  */
+
+#define LX_NAND_METADATA_DIRTY_PAGE_WORDS           ((LX_NAND_PAGE_TYPE_PAGE_NUMBER_MASK + 1) / 32)
+
+
+/* Define the metadata delta records. A delta page holds records of single table entry updates,
+   applied in order on top of the table pages written before it. Unused records are all ones.  */
+
+#define LX_NAND_METADATA_DELTA_ERASE_COUNT          0x01
+#define LX_NAND_METADATA_DELTA_BLOCK_MAPPING        0x02
+#define LX_NAND_METADATA_DELTA_BLOCK_STATUS         0x03
+#define LX_NAND_METADATA_DELTA_END                  0xFF
+
+#define LX_NAND_METADATA_DELTA_RECORD_SIZE          8
+#define LX_NAND_METADATA_DELTA_TABLE_OFFSET         0
+#define LX_NAND_METADATA_DELTA_INDEX_OFFSET         2
+#define LX_NAND_METADATA_DELTA_VALUE_OFFSET         4
+#define LX_NAND_METADATA_DELTA_SEQUENCE_OFFSET      6
+
+
+/* Define the mount anchor states. An anchor page is written at open, when the metadata blocks are
+   rebuilt and at close. The anchor written at close records where the metadata ends.  */
+
+#define LX_NAND_ANCHOR_STATE_MOUNTED                0x00
+#define LX_NAND_ANCHOR_STATE_CLEAN                  0x01
+
+
 #define LX_NAND_DEVICE_INFO_SIGNATURE1              0x76654C20
 #define LX_NAND_DEVICE_INFO_SIGNATURE2              0x20586C65
 
@@ -383,6 +431,44 @@ typedef struct LX_NAND_DEVICE_INFO_STRUCT
 } LX_NAND_DEVICE_INFO;
 
 
+/* Define the NAND mount anchor structure. This is the main data of an anchor page.  */
+
+typedef struct LX_NAND_ANCHOR_STRUCT
+{
+    ULONG                           lx_nand_anchor_signature1;
+    ULONG                           lx_nand_anchor_signature2;
+    ULONG                           lx_nand_anchor_sequence;
+    ULONG                           lx_nand_anchor_metadata_block_number;
+    ULONG                           lx_nand_anchor_backup_metadata_block_number;
+    ULONG                           lx_nand_anchor_metadata_block_current;
+    ULONG                           lx_nand_anchor_metadata_page_current;
+    ULONG                           lx_nand_anchor_state;
+} LX_NAND_ANCHOR;
+
+
+/* Define the NAND flash extended cache entry structure. Each entry holds the page of each
+   sector of one logical group mapped to a non-sequential block.  */
+
+typedef struct LX_NAND_FLASH_EXTENDED_CACHE_ENTRY_STRUCT
+{
+    USHORT                          *lx_nand_flash_extended_cache_entry_page_list;
+    ULONG                           lx_nand_flash_extended_cache_entry_logical_group;
+    ULONG                           lx_nand_flash_extended_cache_entry_block;
+    ULONG                           lx_nand_flash_extended_cache_entry_pages;
+    ULONG                           lx_nand_flash_extended_cache_entry_access_count;
+} LX_NAND_FLASH_EXTENDED_CACHE_ENTRY;
+
+
+/* Define the NAND flash metadata delta structure, one table entry update waiting for the next flush.  */
+
+typedef struct LX_NAND_FLASH_METADATA_DELTA_STRUCT
+{
+    USHORT                          lx_nand_flash_metadata_delta_index;
+    USHORT                          lx_nand_flash_metadata_delta_value;
+    UCHAR                           lx_nand_flash_metadata_delta_table;
+} LX_NAND_FLASH_METADATA_DELTA;
+
+
 /* Determine if the flash control block has an extension defined. If not,
    define the extension to whitespace.  */
 
@@ -415,6 +501,15 @@ typedef struct LX_NAND_FLASH_STRUCT
     ULONG                           lx_nand_flash_block_status_table_size;
     UCHAR                          *lx_nand_flash_erase_count_table;
     ULONG                           lx_nand_flash_erase_count_table_size;
+    ULONG                           lx_nand_flash_block_status_dirty_pages[LX_NAND_METADATA_DIRTY_PAGE_WORDS];
+    ULONG                           lx_nand_flash_erase_count_dirty_pages[LX_NAND_METADATA_DIRTY_PAGE_WORDS];
+    ULONG                           lx_nand_flash_block_mapping_dirty_pages[LX_NAND_METADATA_DIRTY_PAGE_WORDS];
+    USHORT                          lx_nand_flash_metadata_delta_sequence;
+#ifdef LX_NAND_ENABLE_METADATA_DELTA
+    ULONG                           lx_nand_flash_metadata_delta_count;
+    UINT                            lx_nand_flash_metadata_delta_overflow;
+    LX_NAND_FLASH_METADATA_DELTA    lx_nand_flash_metadata_delta[LX_NAND_METADATA_DELTA_RECORDS];
+#endif
     USHORT                         *lx_nand_flash_block_list;
     ULONG                           lx_nand_flash_block_list_size;
     ULONG                           lx_nand_flash_free_block_list_tail;
@@ -425,6 +520,7 @@ typedef struct LX_NAND_FLASH_STRUCT
     ULONG                           lx_nand_flash_block_compaction_table_size;
 #endif
     ULONG                           lx_nand_flash_mapped_block_list_head;
+    ULONG                           lx_nand_flash_defragment_logical_group;
 
     ULONG                           lx_nand_flash_metadata_block_number;
     ULONG                           lx_nand_flash_metadata_block_number_current;
@@ -438,6 +534,12 @@ typedef struct LX_NAND_FLASH_STRUCT
     ULONG                           lx_nand_flash_backup_metadata_block_number_next;
     ULONG                           lx_nand_flash_backup_metadata_block_current_page;
     USHORT                          lx_nand_flash_backup_metadata_block[LX_NAND_FLASH_MAX_METADATA_BLOCKS];
+#ifndef LX_NAND_DISABLE_FAST_MOUNT
+
+    USHORT                          lx_nand_flash_anchor_block[LX_NAND_ANCHOR_BLOCKS];
+    ULONG                           lx_nand_flash_anchor_page[LX_NAND_ANCHOR_BLOCKS];
+    LX_NAND_ANCHOR                  lx_nand_flash_anchor;
+#endif
 
     ULONG                           lx_nand_flash_spare_data1_offset;
     ULONG                           lx_nand_flash_spare_data1_length;
@@ -498,6 +600,8 @@ typedef struct LX_NAND_FLASH_STRUCT
 #endif
     UCHAR                           *lx_nand_flash_page_buffer;
     UINT                            lx_nand_flash_page_buffer_size;
+    USHORT                          *lx_nand_flash_sector_page_list;
+    ULONG                           lx_nand_flash_sector_page_list_size;
 #ifdef LX_THREAD_SAFE_ENABLE
 
     /* When this conditional is used, the LevelX code utilizes a ThreadX mutex for thread
@@ -506,6 +610,17 @@ typedef struct LX_NAND_FLASH_STRUCT
     TX_MUTEX                        lx_nand_flash_mutex;
 #endif
 
+#ifndef LX_NAND_DISABLE_EXTENDED_CACHE
+
+    /* Define the NAND flash extended cache of non-sequential block page lists.  */
+    UINT                            lx_nand_flash_extended_cache_entries;
+    LX_NAND_FLASH_EXTENDED_CACHE_ENTRY
+                                    lx_nand_flash_extended_cache[LX_NAND_EXTENDED_CACHE_SIZE];
+    ULONG                           lx_nand_flash_extended_cache_access_count;
+    ULONG                           lx_nand_flash_extended_cache_hits;
+    ULONG                           lx_nand_flash_extended_cache_misses;
+#endif
+
     /* user data pointer optionally passed by the application to the driver via the lx_nand_flash_open_extended */
     VOID                            *lx_nand_flash_driver_info_ptr;
     /* Define the NAND flash control block open next/previous pointers.  */
@@ -774,6 +889,8 @@ UINT    _lx_nand_flash_driver_block_status_get(LX_NAND_FLASH *nand_flash, ULONG
 UINT    _lx_nand_flash_driver_block_status_set(LX_NAND_FLASH *nand_flash, ULONG block, UCHAR bad_block_flag);
 
 VOID    _lx_nand_flash_internal_error(LX_NAND_FLASH *nand_flash, ULONG error_code);
+UINT    _lx_nand_flash_anchor_find(LX_NAND_FLASH *nand_flash);
+UINT    _lx_nand_flash_anchor_write(LX_NAND_FLASH *nand_flash, ULONG state);
 UINT    _lx_nand_flash_block_find(LX_NAND_FLASH *nand_flash, ULONG logical_sector, ULONG *block, USHORT *block_status);
 UINT    _lx_nand_flash_block_allocate(LX_NAND_FLASH *nand_flash, ULONG *block);
 UINT    _lx_nand_flash_block_data_move(LX_NAND_FLASH* nand_flash, ULONG new_block);
@@ -789,7 +906,18 @@ UINT    _lx_nand_flash_mapped_block_list_remove(LX_NAND_FLASH* nand_flash, ULONG
 UINT    _lx_nand_flash_memory_initialize(LX_NAND_FLASH* nand_flash, ULONG* memory_ptr, UINT memory_size);
 UINT    _lx_nand_flash_metadata_allocate(LX_NAND_FLASH* nand_flash);
 UINT    _lx_nand_flash_metadata_build(LX_NAND_FLASH* nand_flash);
+UINT    _lx_nand_flash_metadata_delta_add(LX_NAND_FLASH *nand_flash, UINT table, ULONG index, ULONG value);
+UINT    _lx_nand_flash_metadata_delta_apply(LX_NAND_FLASH *nand_flash, UCHAR *page_buffer);
+UINT    _lx_nand_flash_metadata_flush(LX_NAND_FLASH *nand_flash);
 UINT    _lx_nand_flash_metadata_write(LX_NAND_FLASH *nand_flash, UCHAR* main_buffer, ULONG spare_value);
+UINT    _lx_nand_flash_logical_group_consolidate(LX_NAND_FLASH *nand_flash, ULONG logical_group, UINT *consolidated);
+UINT    _lx_nand_flash_logical_sector_release(LX_NAND_FLASH *nand_flash, ULONG logical_sector);
+UINT    _lx_nand_flash_mapped_block_verify(LX_NAND_FLASH *nand_flash);
+UINT    _lx_nand_flash_logical_group_read(LX_NAND_FLASH *nand_flash, ULONG logical_sector, UCHAR *buffer, ULONG sector_count);
+UINT    _lx_nand_flash_logical_group_write(LX_NAND_FLASH *nand_flash, ULONG logical_sector, UCHAR *buffer, ULONG sector_count);
+UINT    _lx_nand_flash_extended_cache_invalidate(LX_NAND_FLASH *nand_flash, ULONG logical_group);
+UINT    _lx_nand_flash_extended_cache_page_list_get(LX_NAND_FLASH *nand_flash, ULONG logical_group, ULONG block, USHORT block_status, USHORT **page_list);
+UINT    _lx_nand_flash_sector_pages_find(LX_NAND_FLASH *nand_flash, ULONG block, USHORT block_status, ULONG logical_sector, ULONG sector_count, USHORT *page_list);
 VOID    _lx_nand_flash_system_error(LX_NAND_FLASH *nand_flash, UINT error_code, ULONG block, ULONG page);
 UINT    _lx_nand_flash_256byte_ecc_check(UCHAR *page_buffer, UCHAR *ecc_buffer);
 UINT    _lx_nand_flash_256byte_ecc_compute(UCHAR *page_buffer, UCHAR *ecc_buffer);
@@ -69,6 +69,50 @@
 #define LX_NAND_FLASH_MAX_METADATA_BLOCKS 4
 */
 
+/* Defined, this disables the extended NAND cache.  */
+/*
+#define LX_NAND_DISABLE_EXTENDED_CACHE
+*/
+
+/* By default this value is 8, which represents a maximum of 8 logical groups
+   whose page lists can be cached in a NAND instance. Each cached group takes
+   pages per block * 2 bytes of the memory supplied to
+   lx_nand_flash_extended_cache_enable.
+*/
+/*
+#define LX_NAND_EXTENDED_CACHE_SIZE   8
+*/
+
+/* Defined, this enables the NAND metadata delta pages. A metadata flush
+   with few table updates writes them as records in one delta page
+   instead of the changed table pages. Older versions of LevelX can't
+   read a flash that holds delta pages, so this is disabled by default.  */
+/*
+#define LX_NAND_ENABLE_METADATA_DELTA
+*/
+
+/* By default this value is 32, which represents a maximum of 32 table
+   updates written in one metadata delta page. More updates between two
+   flushes are written as full table pages.
+*/
+/*
+#define LX_NAND_METADATA_DELTA_RECORDS  32
+*/
+
+/* Defined, this disables the NAND mount anchor. Open then searches the
+   flash for the metadata and checks the mapped blocks after each open,
+   not only after a power loss.  */
+/*
+#define LX_NAND_DISABLE_FAST_MOUNT
+*/
+
+/* By default this value is 2, which represents 2 blocks at the start of
+   the NAND flash reserved by format for the mount anchor.
+*/
+/*
+#define LX_NAND_ANCHOR_BLOCKS  2
+*/
+
 /* Defined, this disabled the extended NOR cache.  */
 /*
 #define LX_NOR_DISABLE_EXTENDED_CACHE
@@ -112,6 +112,8 @@ VOID  _fx_nand_flash_simulator_driver(FX_MEDIA *media_ptr);
 /*    _lx_nand_flash_sector_read            Read a NAND sector            */
 /*    _lx_nand_flash_sector_release         Release a NAND sector         */
 /*    _lx_nand_flash_sector_write           Write a NAND sector           */
+/*    _lx_nand_flash_sectors_read           Read NAND sectors             */
+/*    _lx_nand_flash_sectors_write          Write NAND sectors            */
 /*                                                                        */
 /*  CALLED BY                                                             */
 /*                                                                        */
@@ -208,27 +210,20 @@ UINT    status;
             logical_sector =  media_ptr -> fx_media_driver_logical_sector;
             count =  media_ptr -> fx_media_driver_sectors;
             buffer = (UCHAR *) media_ptr -> fx_media_driver_buffer;
-            while (count)
-            {
-
-                /* Call LevelX to read one flash sector.  */
-                status =  _lx_nand_flash_sector_read(&nand_flash, logical_sector, buffer);
 
-                /* Determine if the read was successful.  */
-                if (status != LX_SUCCESS)
-                {
+            /* Call LevelX to read the flash sectors.  */
+            status =  _lx_nand_flash_sectors_read(&nand_flash, logical_sector, buffer, count);
 
-                    /* Return an I/O error to FileX.  */
-                    media_ptr -> fx_media_driver_status =  FX_IO_ERROR;
+            /* Determine if the read was successful.  */
+            if (status != LX_SUCCESS)
+            {
 
-                    return;
-                }
+                /* Return an I/O error to FileX.  */
+                media_ptr -> fx_media_driver_status =  FX_IO_ERROR;
 
-                /* Successful sector read.  */
-                count--;
-                logical_sector++;
-                buffer += media_ptr -> fx_media_bytes_per_sector;
+                return;
             }
+
             /* Successful driver request.  */
             media_ptr -> fx_media_driver_status =  FX_SUCCESS;
             break;
@@ -241,26 +236,18 @@ UINT    status;
             logical_sector =  media_ptr -> fx_media_driver_logical_sector;
             count =  media_ptr -> fx_media_driver_sectors;
             buffer = (UCHAR *) media_ptr -> fx_media_driver_buffer;
-            while (count)
-            {
-
-                /* Call LevelX to write a sector.  */
-                status =  _lx_nand_flash_sector_write(&nand_flash, logical_sector, buffer);
 
-                /* Determine if the write was successful.  */
-                if (status != LX_SUCCESS)
-                {
+            /* Call LevelX to write the flash sectors.  */
+            status =  _lx_nand_flash_sectors_write(&nand_flash, logical_sector, buffer, count);
 
-                    /* Return an I/O error to FileX.  */
-                    media_ptr -> fx_media_driver_status =  FX_IO_ERROR;
+            /* Determine if the write was successful.  */
+            if (status != LX_SUCCESS)
+            {
 
-                    return;
-                }
+                /* Return an I/O error to FileX.  */
+                media_ptr -> fx_media_driver_status =  FX_IO_ERROR;
 
-                /* Successful sector write.  */
-                count--;
-                logical_sector++;
-                buffer += media_ptr -> fx_media_bytes_per_sector;
+                return;
             }
 
             /* Successful driver request.  */
@@ -0,0 +1,304 @@
+/***************************************************************************
+ * Copyright (c) 2026-present Eclipse ThreadX contributors
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the MIT License which is available at
+ * https://opensource.org/licenses/MIT.
+ *
+ * SPDX-License-Identifier: MIT
+ **************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */
+/** LevelX Component                                                      */
+/**                                                                       */
+/**   NAND Flash                                                          */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+#define LX_SOURCE_CODE
+
+
+/* Disable ThreadX error checking.  */
+
+#ifndef LX_DISABLE_ERROR_CHECKING
+#define LX_DISABLE_ERROR_CHECKING
+#endif
+
+
+/* Include necessary system files.  */
+
+#include "lx_api.h"
+
+
+
+
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _lx_nand_flash_anchor_find                          PORTABLE C      */
+/*                                                           6.5.1        */
+/*  AUTHOR                                                                */
+/*                                                                        */
+/*    Eclipse ThreadX contributors                                        */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function finds the anchor blocks at the start of the flash     */
+/*    and reads the latest anchor. The last written page of each block is */
+/*    found with a binary search. If the first metadata block pointed at  */
+/*    by the anchor holds the device info, the metadata block numbers are */
+/*    set and the anchor is saved in the control block.                   */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    nand_flash                            NAND flash instance           */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    return status                                                       */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    _lx_nand_flash_driver_block_status_get                              */
+/*                                          Driver block status get       */
+/*    (lx_nand_flash_driver_pages_read)     Read pages                    */
+/*    _lx_nand_flash_system_error           Internal system error handler */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    _lx_nand_flash_open_extended                                        */
+/*                                                                        */
+/**************************************************************************/
+UINT  _lx_nand_flash_anchor_find(LX_NAND_FLASH *nand_flash)
+{
+
+#ifndef LX_NAND_DISABLE_FAST_MOUNT
+UINT                    i;
+ULONG                   block;
+ULONG                   page;
+ULONG                   low;
+ULONG                   high;
+UINT                    status;
+UCHAR                   block_status;
+UINT                    anchor_found;
+UCHAR                   *page_buffer_ptr;
+UCHAR                   *spare_buffer_ptr;
+LX_NAND_ANCHOR          anchor;
+LX_NAND_DEVICE_INFO     *nand_device_info_page;
+
+
+    /* Setup page buffer and spare buffer pointers.  */
+    page_buffer_ptr = nand_flash -> lx_nand_flash_page_buffer;
+    spare_buffer_ptr = page_buffer_ptr + nand_flash -> lx_nand_flash_bytes_per_page;
+
+    /* No anchor found yet.  */
+    anchor_found = LX_FALSE;
+
+    /* Loop to initialize the anchor blocks.  */
+    for (i = 0; i < LX_NAND_ANCHOR_BLOCKS; i++)
+    {
+        nand_flash -> lx_nand_flash_anchor_block[i] = LX_NAND_BLOCK_UNMAPPED;
+    }
+
+    /* Loop through the blocks at the start of the flash to find the good blocks reserved for the anchor.  */
+    block = 0;
+    for (i = 0; (i < LX_NAND_ANCHOR_BLOCKS) && (block < nand_flash -> lx_nand_flash_total_blocks); block++)
+    {
+
+        /* First, check to make sure this block is good.  */
+        status =  _lx_nand_flash_driver_block_status_get(nand_flash, block, &block_status);
+
+        /* Check for an error from flash driver.   */
+        if (status)
+        {
+
+            /* Call system error handler.  */
+            _lx_nand_flash_system_error(nand_flash, status, block, 0);
+
+            /* Return an error.  */
+            return(LX_ERROR);
+        }
+
+        /* Skip bad blocks.  */
+        if (block_status != LX_NAND_GOOD_BLOCK)
+        {
+            continue;
+        }
+
+        /* Loop to find the first erased page. Anchor pages are written in order.  */
+        low = 0;
+        high = nand_flash -> lx_nand_flash_pages_per_block;
+        while (low < high)
+        {
+
+            /* Pick the page in the middle.  */
+            page = (low + high) / 2;
+
+            /* Read the spare data of the page.  */
+#ifdef LX_NAND_ENABLE_CONTROL_BLOCK_FOR_DRIVER_INTERFACE
+            status = (nand_flash -> lx_nand_flash_driver_pages_read)(nand_flash, block, page, LX_NULL, spare_buffer_ptr, 1);
+#else
+            status = (nand_flash -> lx_nand_flash_driver_pages_read)(block, page, LX_NULL, spare_buffer_ptr, 1);
+#endif
+
+            /* Check for an error from flash driver.   */
+            if (status)
+            {
+
+                /* Call system error handler.  */
+                _lx_nand_flash_system_error(nand_flash, status, block, page);
+
+                /* Determine if the error is fatal.  */
+                if (status != LX_NAND_ERROR_CORRECTED)
+                {
+
+                    /* Return an error.  */
+                    return(LX_ERROR);
+                }
+            }
+
+            /* Check if the page is erased.  */
+            if (LX_UTILITY_LONG_GET(&spare_buffer_ptr[nand_flash -> lx_nand_flash_spare_data1_offset]) == LX_ALL_ONES)
+            {
+                high = page;
+            }
+            else
+            {
+                low = page + 1;
+            }
+        }
+
+        /* Save the anchor block and its next page.  */
+        nand_flash -> lx_nand_flash_anchor_block[i] = (USHORT)block;
+        nand_flash -> lx_nand_flash_anchor_page[i] = low;
+        i++;
+
+        /* Check if the block has no anchor.  */
+        if (low == 0)
+        {
+            continue;
+        }
+
+        /* Read the last written page.  */
+#ifdef LX_NAND_ENABLE_CONTROL_BLOCK_FOR_DRIVER_INTERFACE
+        status = (nand_flash -> lx_nand_flash_driver_pages_read)(nand_flash, block, low - 1, page_buffer_ptr, spare_buffer_ptr, 1);
+#else
+        status = (nand_flash -> lx_nand_flash_driver_pages_read)(block, low - 1, page_buffer_ptr, spare_buffer_ptr, 1);
+#endif
+
+        /* Check for an error from flash driver.   */
+        if (status)
+        {
+
+            /* Call system error handler.  */
+            _lx_nand_flash_system_error(nand_flash, status, block, low - 1);
+
+            /* Determine if the error is fatal.  */
+            if (status != LX_NAND_ERROR_CORRECTED)
+            {
+
+                /* Skip the block, the other anchor block is still used.  */
+                continue;
+            }
+        }
+
+        /* Check if the page is an anchor.  */
+        if (LX_UTILITY_LONG_GET(&spare_buffer_ptr[nand_flash -> lx_nand_flash_spare_data1_offset]) != LX_NAND_PAGE_TYPE_ANCHOR)
+        {
+
+            /* Not an anchor block, the flash was formatted without anchor.  */
+            return(LX_ERROR);
+        }
+
+        /* Check the signature and keep the latest anchor.  */
+        if ((((LX_NAND_ANCHOR*)page_buffer_ptr) -> lx_nand_anchor_signature1 == LX_NAND_DEVICE_INFO_SIGNATURE1) &&
+            (((LX_NAND_ANCHOR*)page_buffer_ptr) -> lx_nand_anchor_signature2 == LX_NAND_DEVICE_INFO_SIGNATURE2) &&
+            ((anchor_found == LX_FALSE) || (((LX_NAND_ANCHOR*)page_buffer_ptr) -> lx_nand_anchor_sequence > anchor.lx_nand_anchor_sequence)))
+        {
+
+            /* Save the anchor.  */
+            LX_MEMCPY(&anchor, page_buffer_ptr, sizeof(LX_NAND_ANCHOR)); /* Use case of memcpy is verified. */
+            anchor_found = LX_TRUE;
+        }
+    }
+
+    /* Check if an anchor is found.  */
+    if (anchor_found == LX_FALSE)
+    {
+
+        /* Return an error.  */
+        return(LX_ERROR);
+    }
+
+    /* Continue the anchor sequence, even if the metadata has to be searched.  */
+    nand_flash -> lx_nand_flash_anchor.lx_nand_anchor_sequence = anchor.lx_nand_anchor_sequence;
+
+    /* Check the metadata block number.  */
+    if (anchor.lx_nand_anchor_metadata_block_number >= nand_flash -> lx_nand_flash_total_blocks)
+    {
+
+        /* Return an error.  */
+        return(LX_ERROR);
+    }
+
+    /* Read the first page of the metadata block.  */
+#ifdef LX_NAND_ENABLE_CONTROL_BLOCK_FOR_DRIVER_INTERFACE
+    status = (nand_flash -> lx_nand_flash_driver_pages_read)(nand_flash, anchor.lx_nand_anchor_metadata_block_number, 0, page_buffer_ptr, spare_buffer_ptr, 1);
+#else
+    status = (nand_flash -> lx_nand_flash_driver_pages_read)(anchor.lx_nand_anchor_metadata_block_number, 0, page_buffer_ptr, spare_buffer_ptr, 1);
+#endif
+
+    /* Check for an error from flash driver.   */
+    if (status)
+    {
+
+        /* Call system error handler.  */
+        _lx_nand_flash_system_error(nand_flash, status, anchor.lx_nand_anchor_metadata_block_number, 0);
+
+        /* Determine if the error is fatal.  */
+        if (status != LX_NAND_ERROR_CORRECTED)
+        {
+
+            /* Return an error.  */
+            return(LX_ERROR);
+        }
+    }
+
+    /* Get the device info page.  */
+    nand_device_info_page = (LX_NAND_DEVICE_INFO*)page_buffer_ptr;
+
+    /* Check that the block still starts the metadata pointed at by the anchor.  */
+    if ((LX_UTILITY_LONG_GET(&spare_buffer_ptr[nand_flash -> lx_nand_flash_spare_data1_offset]) != LX_NAND_PAGE_TYPE_DEVICE_INFO) ||
+        (nand_device_info_page -> lx_nand_device_info_signature1 != LX_NAND_DEVICE_INFO_SIGNATURE1) ||
+        (nand_device_info_page -> lx_nand_device_info_signature2 != LX_NAND_DEVICE_INFO_SIGNATURE2) ||
+        (nand_device_info_page -> lx_nand_device_info_metadata_block_number != anchor.lx_nand_anchor_metadata_block_number) ||
+        (nand_device_info_page -> lx_nand_device_info_backup_metadata_block_number != anchor.lx_nand_anchor_backup_metadata_block_number))
+    {
+
+        /* The anchor is out of date, return an error.  */
+        return(LX_ERROR);
+    }
+
+    /* Save the block numbers.  */
+    nand_flash -> lx_nand_flash_metadata_block_number = anchor.lx_nand_anchor_metadata_block_number;
+    nand_flash -> lx_nand_flash_backup_metadata_block_number = anchor.lx_nand_anchor_backup_metadata_block_number;
+
+    /* Save the anchor.  */
+    nand_flash -> lx_nand_flash_anchor = anchor;
+
+    /* Return successful completion.  */
+    return(LX_SUCCESS);
+#else
+
+    LX_PARAMETER_NOT_USED(nand_flash);
+
+    /* Return an error, the metadata has to be searched.  */
+    return(LX_ERROR);
+#endif
+}
+
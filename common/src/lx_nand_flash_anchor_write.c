@@ -0,0 +1,193 @@
+/***************************************************************************
+ * Copyright (c) 2026-present Eclipse ThreadX contributors
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the MIT License which is available at
+ * https://opensource.org/licenses/MIT.
+ *
+ * SPDX-License-Identifier: MIT
+ **************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */
+/** LevelX Component                                                      */
+/**                                                                       */
+/**   NAND Flash                                                          */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+#define LX_SOURCE_CODE
+
+
+/* Disable ThreadX error checking.  */
+
+#ifndef LX_DISABLE_ERROR_CHECKING
+#define LX_DISABLE_ERROR_CHECKING
+#endif
+
+
+/* Include necessary system files.  */
+
+#include "lx_api.h"
+
+
+
+
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _lx_nand_flash_anchor_write                         PORTABLE C      */
+/*                                                           6.5.1        */
+/*  AUTHOR                                                                */
+/*                                                                        */
+/*    Eclipse ThreadX contributors                                        */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function writes an anchor page to each anchor block. The       */
+/*    anchor points at the first metadata block and records the end of    */
+/*    the metadata, so open can find the metadata without searching the   */
+/*    flash. A full anchor block is erased before the page is written,    */
+/*    its new erase count is written by the next metadata flush of the    */
+/*    caller.                                                             */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    nand_flash                            NAND flash instance           */
+/*    state                                 Anchor state                  */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    return status                                                       */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    _lx_nand_flash_driver_block_erase     Erase block                   */
+/*    _lx_nand_flash_erase_count_set        Set erase count               */
+/*    (lx_nand_flash_driver_pages_write)    Write pages                   */
+/*    _lx_nand_flash_system_error           Internal system error handler */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    Internal LevelX                                                     */
+/*                                                                        */
+/**************************************************************************/
+UINT  _lx_nand_flash_anchor_write(LX_NAND_FLASH *nand_flash, ULONG state)
+{
+
+#ifndef LX_NAND_DISABLE_FAST_MOUNT
+UINT            i;
+ULONG           block;
+UINT            status;
+UCHAR           *page_buffer_ptr;
+UCHAR           *spare_buffer_ptr;
+LX_NAND_ANCHOR  *anchor_ptr;
+
+
+    /* Setup anchor pointer.  */
+    anchor_ptr = &nand_flash -> lx_nand_flash_anchor;
+
+    /* Move to the next anchor, all the copies of one anchor share the sequence number.  */
+    anchor_ptr -> lx_nand_anchor_sequence++;
+
+    /* Loop to write the anchor to each anchor block.  */
+    for (i = 0; i < LX_NAND_ANCHOR_BLOCKS; i++)
+    {
+
+        /* Get the anchor block.  */
+        block = nand_flash -> lx_nand_flash_anchor_block[i];
+
+        /* Skip anchor blocks that are not available.  */
+        if (block == LX_NAND_BLOCK_UNMAPPED)
+        {
+            continue;
+        }
+
+        /* Check if the anchor block is full.  */
+        if (nand_flash -> lx_nand_flash_anchor_page[i] >= nand_flash -> lx_nand_flash_pages_per_block)
+        {
+
+            /* Erase the block. The anchor blocks are written in lockstep and fill
+               up in the same call, so the blocks before this one already hold the
+               new anchor and the blocks after it still hold the last one. If only
+               one anchor block is left, the next open falls back to the scan until
+               the block is written again.  */
+            status = _lx_nand_flash_driver_block_erase(nand_flash, block, nand_flash -> lx_nand_flash_base_erase_count + nand_flash -> lx_nand_flash_erase_count_table[block] + 1);
+
+            /* Check for an error from flash driver.   */
+            if (status)
+            {
+
+                /* Call system error handler.  */
+                _lx_nand_flash_system_error(nand_flash, status, block, 0);
+
+                /* Return an error.  */
+                return(LX_ERROR);
+            }
+
+            /* Update erase count for the block.  */
+            _lx_nand_flash_erase_count_set(nand_flash, block, (UCHAR)(nand_flash -> lx_nand_flash_erase_count_table[block] + 1));
+
+            /* Start from the first page. The erase count is written by the next
+               metadata flush of the caller.  */
+            nand_flash -> lx_nand_flash_anchor_page[i] = 0;
+        }
+
+        /* Build the anchor.  */
+        anchor_ptr -> lx_nand_anchor_signature1 = LX_NAND_DEVICE_INFO_SIGNATURE1;
+        anchor_ptr -> lx_nand_anchor_signature2 = LX_NAND_DEVICE_INFO_SIGNATURE2;
+        anchor_ptr -> lx_nand_anchor_metadata_block_number = nand_flash -> lx_nand_flash_metadata_block_number;
+        anchor_ptr -> lx_nand_anchor_backup_metadata_block_number = nand_flash -> lx_nand_flash_backup_metadata_block_number;
+        anchor_ptr -> lx_nand_anchor_metadata_block_current = nand_flash -> lx_nand_flash_metadata_block_number_current;
+        anchor_ptr -> lx_nand_anchor_metadata_page_current = nand_flash -> lx_nand_flash_metadata_block_current_page;
+        anchor_ptr -> lx_nand_anchor_state = state;
+
+        /* Setup page buffer and spare buffer pointers.  */
+        page_buffer_ptr = nand_flash -> lx_nand_flash_page_buffer;
+        spare_buffer_ptr = page_buffer_ptr + nand_flash -> lx_nand_flash_bytes_per_page;
+
+        /* Initialize the page and the spare data.  */
+        LX_MEMSET(page_buffer_ptr, 0xFF, nand_flash -> lx_nand_flash_bytes_per_page);
+        LX_MEMSET(spare_buffer_ptr, 0xFF, nand_flash -> lx_nand_flash_spare_total_length);
+
+        /* Copy the anchor to the page.  */
+        LX_MEMCPY(page_buffer_ptr, anchor_ptr, sizeof(LX_NAND_ANCHOR)); /* Use case of memcpy is verified. */
+
+        /* Save the page type in spare bytes.  */
+        LX_UTILITY_LONG_SET(&spare_buffer_ptr[nand_flash -> lx_nand_flash_spare_data1_offset], LX_NAND_PAGE_TYPE_ANCHOR);
+
+        /* Write the page.  */
+#ifdef LX_NAND_ENABLE_CONTROL_BLOCK_FOR_DRIVER_INTERFACE
+        status = (nand_flash -> lx_nand_flash_driver_pages_write)(nand_flash, block, nand_flash -> lx_nand_flash_anchor_page[i], page_buffer_ptr, spare_buffer_ptr, 1);
+#else
+        status = (nand_flash -> lx_nand_flash_driver_pages_write)(block, nand_flash -> lx_nand_flash_anchor_page[i], page_buffer_ptr, spare_buffer_ptr, 1);
+#endif
+
+        /* Check for an error from flash driver.   */
+        if (status)
+        {
+
+            /* Call system error handler.  */
+            _lx_nand_flash_system_error(nand_flash, status, block, nand_flash -> lx_nand_flash_anchor_page[i]);
+
+            /* Return an error.  */
+            return(LX_ERROR);
+        }
+
+        /* Move to the next page of the anchor block.  */
+        nand_flash -> lx_nand_flash_anchor_page[i]++;
+    }
+#else
+
+    LX_PARAMETER_NOT_USED(nand_flash);
+    LX_PARAMETER_NOT_USED(state);
+#endif
+
+    /* Return successful completion.  */
+    return(LX_SUCCESS);
+}
+
@@ -61,7 +61,10 @@
 /*                                                                        */
 /*  CALLS                                                                 */
 /*                                                                        */
-/*    _lx_nand_flash_metadata_write         Write metadata                */
+/*    _lx_nand_flash_extended_cache_invalidate                            */
+/*                                          Invalidate cached page list   */
+/*    _lx_nand_flash_metadata_delta_add     Record table update           */
+/*    _lx_nand_flash_metadata_flush         Flush metadata updates        */
 /*                                                                        */
 /*  CALLED BY                                                             */
 /*                                                                        */
@@ -87,16 +90,24 @@ UINT    status;
         return(LX_ERROR);
     }
 
+    /* Drop the cached page list of the logical group.  */
+    _lx_nand_flash_extended_cache_invalidate(nand_flash, block_mapping_index);
+
     /* Save the block number to mapping table.  */
     nand_flash -> lx_nand_flash_block_mapping_table[block_mapping_index] = (USHORT)block;
 
-    /* Get the page number to write.  */
+    /* Get the page number of the table entry.  */
     page_number = (UCHAR)(block_mapping_index * sizeof(*nand_flash -> lx_nand_flash_block_mapping_table) / nand_flash -> lx_nand_flash_bytes_per_page);
 
-    /* Save the mapping table.  */
-    status = _lx_nand_flash_metadata_write(nand_flash, ((UCHAR*)nand_flash -> lx_nand_flash_block_mapping_table) +
-                                                page_number * nand_flash -> lx_nand_flash_bytes_per_page,
-                                                LX_NAND_PAGE_TYPE_BLOCK_MAPPING_TABLE | page_number);
+    /* Mark the table page as dirty.  */
+    nand_flash -> lx_nand_flash_block_mapping_dirty_pages[page_number / 32] |= ((ULONG)1 << (page_number % 32));
+
+    /* Record the update.  */
+    _lx_nand_flash_metadata_delta_add(nand_flash, LX_NAND_METADATA_DELTA_BLOCK_MAPPING, block_mapping_index, block);
+
+    /* Write the mapping together with the pending block status and erase count updates, so the mapping
+       never reaches flash before the status of the blocks it refers to.  */
+    status = _lx_nand_flash_metadata_flush(nand_flash);
 
     /* Return status.  */
     return(status);
@@ -47,7 +47,9 @@
 /*                                                                        */
 /*  DESCRIPTION                                                           */
 /*                                                                        */
-/*    This function sets block status.                                    */
+/*    This function sets block status. The table page holding the         */
+/*    status is marked dirty and is written to flash by the next          */
+/*    metadata flush.                                                     */
 /*                                                                        */
 /*  INPUT                                                                 */
 /*                                                                        */
@@ -61,7 +63,7 @@
 /*                                                                        */
 /*  CALLS                                                                 */
 /*                                                                        */
-/*    _lx_nand_flash_metadata_write         Write metadata                */
+/*    _lx_nand_flash_metadata_delta_add     Record table update           */
 /*                                                                        */
 /*  CALLED BY                                                             */
 /*                                                                        */
@@ -72,20 +74,21 @@ UINT  _lx_nand_flash_block_status_set(LX_NAND_FLASH *nand_flash, ULONG block, UL
 {
 
 UCHAR   page_number;
-UINT    status;
 
 
     /* Save the block status to status table.  */
     nand_flash -> lx_nand_flash_block_status_table[block] = (USHORT)block_status;
 
-    /* Get the page number to write.  */
+    /* Get the page number of the table entry.  */
     page_number = (UCHAR)(block * sizeof(*nand_flash -> lx_nand_flash_block_status_table) / nand_flash -> lx_nand_flash_bytes_per_page);
 
-    /* Save the status table.  */
-    status = _lx_nand_flash_metadata_write(nand_flash, ((UCHAR*)nand_flash -> lx_nand_flash_block_status_table) +
-                                            page_number * nand_flash -> lx_nand_flash_bytes_per_page, LX_NAND_PAGE_TYPE_BLOCK_STATUS_TABLE | page_number);
+    /* Mark the table page as dirty. The page is written by the next metadata flush.  */
+    nand_flash -> lx_nand_flash_block_status_dirty_pages[page_number / 32] |= ((ULONG)1 << (page_number % 32));
 
-    /* Return status.  */
-    return(status);
+    /* Record the update for the next metadata flush.  */
+    _lx_nand_flash_metadata_delta_add(nand_flash, LX_NAND_METADATA_DELTA_BLOCK_STATUS, block, block_status);
+
+    /* Return successful completion.  */
+    return(LX_SUCCESS);
 }
 
@@ -59,6 +59,10 @@
 /*                                                                        */
 /*  CALLS                                                                 */
 /*                                                                        */
+/*    _lx_nand_flash_metadata_flush         Flush metadata updates        */
+/*    _lx_nand_flash_anchor_write           Write the mount anchor        */
+/*    tx_mutex_get                          Get thread protection         */
+/*    tx_mutex_put                          Release thread protection     */
 /*    tx_mutex_delete                       Delete thread-safe mutex      */
 /*                                                                        */
 /*  CALLED BY                                                             */
@@ -69,9 +73,61 @@
 UINT  _lx_nand_flash_close(LX_NAND_FLASH *nand_flash)
 {
 
+UINT    status;
+ULONG   block;
+ULONG   page;
 LX_INTERRUPT_SAVE_AREA
 
 
+#ifdef LX_THREAD_SAFE_ENABLE
+
+    /* Obtain the thread safe mutex.  */
+    tx_mutex_get(&nand_flash -> lx_nand_flash_mutex, TX_WAIT_FOREVER);
+#endif
+
+    /* Write the pending metadata updates.  */
+    status = _lx_nand_flash_metadata_flush(nand_flash);
+
+    /* Write the anchor of the clean shutdown, so the next open skips the recovery.  */
+    if (status == LX_SUCCESS)
+    {
+        status = _lx_nand_flash_anchor_write(nand_flash, LX_NAND_ANCHOR_STATE_CLEAN);
+    }
+
+    /* Remember the end of the metadata.  */
+    block =  nand_flash -> lx_nand_flash_metadata_block_number_current;
+    page =  nand_flash -> lx_nand_flash_metadata_block_current_page;
+
+    /* Write the erase count of an anchor block erased by the anchor write.  */
+    if (status == LX_SUCCESS)
+    {
+        status = _lx_nand_flash_metadata_flush(nand_flash);
+    }
+
+    /* Check if the metadata has grown, the anchor must record its end.  */
+    if ((status == LX_SUCCESS) &&
+        ((block != nand_flash -> lx_nand_flash_metadata_block_number_current) ||
+         (page != nand_flash -> lx_nand_flash_metadata_block_current_page)))
+    {
+
+        /* Write the anchor again.  */
+        status = _lx_nand_flash_anchor_write(nand_flash, LX_NAND_ANCHOR_STATE_CLEAN);
+    }
+
+#ifdef LX_THREAD_SAFE_ENABLE
+
+    /* Release the thread safe mutex.  */
+    tx_mutex_put(&nand_flash -> lx_nand_flash_mutex);
+#endif
+
+    /* Check for an error.  */
+    if (status != LX_SUCCESS)
+    {
+
+        /* Return an error.  */
+        return(LX_ERROR);
+    }
+
     /* Lockout interrupts for NAND flash close.  */
     LX_DISABLE
 
@@ -41,7 +41,7 @@
 /*  FUNCTION                                               RELEASE        */
 /*                                                                        */
 /*    _lx_nand_flash_defragment                           PORTABLE C      */
-/*                                                           6.2.1       */
+/*                                                           6.5.1        */
 /*  AUTHOR                                                                */
 /*                                                                        */
 /*    William E. Lamie, Microsoft Corporation                             */
@@ -60,9 +60,7 @@
 /*                                                                        */
 /*  CALLS                                                                 */
 /*                                                                        */
-/*    _lx_nand_flash_block_reclaim          Reclaim a NAND flash block    */
-/*    tx_mutex_get                          Get thread protection         */
-/*    tx_mutex_put                          Release thread protection     */
+/*    _lx_nand_flash_partial_defragment     Partially defragment          */
 /*                                                                        */
 /*  CALLED BY                                                             */
 /*                                                                        */
@@ -73,38 +71,7 @@
 UINT  _lx_nand_flash_defragment(LX_NAND_FLASH *nand_flash)
 {
 
-#ifdef LX_NAND_FLASH_ENABLE_LAZY_SECTOR_RELEASE
-
-UINT    status;
-ULONG   lg;
-
-    /* Compact every logical group that has a deferred compaction pending.  */
-    for (lg = 0; lg < nand_flash -> lx_nand_flash_total_blocks; lg++)
-    {
-
-        if (nand_flash -> lx_nand_flash_block_compaction_table[lg] != (USHORT)LX_NAND_BLOCK_UNMAPPED)
-        {
-
-            status = _lx_nand_flash_logical_group_compact(nand_flash, lg);
-
-            /* On error, continue to compact remaining groups.  */
-            if (status)
-            {
-                _lx_nand_flash_system_error(nand_flash, status, lg, 0);
-            }
-        }
-    }
-
-    return(LX_SUCCESS);
-
-#else
-
-    LX_PARAMETER_NOT_USED(nand_flash);
-
-    /* Return not supported.  */
-    return(LX_NOT_SUPPORTED);
-
-#endif /* LX_NAND_FLASH_ENABLE_LAZY_SECTOR_RELEASE */
+    /* Defragment all the blocks.  */
+    return(_lx_nand_flash_partial_defragment(nand_flash, (UINT)nand_flash -> lx_nand_flash_total_blocks));
 }
 
-
@@ -47,7 +47,14 @@
 /*                                                                        */
 /*  DESCRIPTION                                                           */
 /*                                                                        */
-/*    This function sets block erase count.                               */
+/*    This function sets block erase count. The table page holding the    */
+/*    erase count is marked dirty and is written to flash by the next     */
+/*    metadata flush, at the latest at the end of the request.            */
+/*                                                                        */
+/*    If power is lost before the flush, the erase is not counted. The    */
+/*    block erased by the request is still allocated and unmapped on      */
+/*    flash, so the next open erases it again and counts that erase       */
+/*    instead, the erase count is at most one behind.                     */
 /*                                                                        */
 /*  INPUT                                                                 */
 /*                                                                        */
@@ -61,7 +68,7 @@
 /*                                                                        */
 /*  CALLS                                                                 */
 /*                                                                        */
-/*    _lx_nand_flash_metadata_write         Write metadata                */
+/*    _lx_nand_flash_metadata_delta_add     Record table update           */
 /*                                                                        */
 /*  CALLED BY                                                             */
 /*                                                                        */
@@ -72,21 +79,21 @@ UINT  _lx_nand_flash_erase_count_set(LX_NAND_FLASH *nand_flash, ULONG block, UCH
 {
 
 UCHAR   page_number;
-UINT    status;
 
 
     /* Save the erase count to erase count table.  */
     nand_flash -> lx_nand_flash_erase_count_table[block] = erase_count;
 
-    /* Get the page number to write.  */
+    /* Get the page number of the table entry.  */
     page_number = (UCHAR)(block * sizeof(*nand_flash -> lx_nand_flash_erase_count_table) / nand_flash -> lx_nand_flash_bytes_per_page);
 
-    /* Save the erase count table.  */
-    status = _lx_nand_flash_metadata_write(nand_flash, ((UCHAR*)nand_flash -> lx_nand_flash_erase_count_table) +
-                                            page_number * nand_flash -> lx_nand_flash_bytes_per_page,
-                                            LX_NAND_PAGE_TYPE_ERASE_COUNT_TABLE | page_number);
+    /* Mark the table page as dirty. The page is written by the next metadata flush.  */
+    nand_flash -> lx_nand_flash_erase_count_dirty_pages[page_number / 32] |= ((ULONG)1 << (page_number % 32));
+
+    /* Record the update for the next metadata flush.  */
+    _lx_nand_flash_metadata_delta_add(nand_flash, LX_NAND_METADATA_DELTA_ERASE_COUNT, block, erase_count);
 
-    /* Return sector not found status.  */
-    return(status);
+    /* Return successful completion.  */
+    return(LX_SUCCESS);
 }
 
@@ -40,17 +40,21 @@
 /*  FUNCTION                                               RELEASE        */
 /*                                                                        */
 /*    _lx_nand_flash_extended_cache_enable                PORTABLE C      */
-/*                                                           6.2.1       */
+/*                                                           6.5.1        */
 /*  AUTHOR                                                                */
 /*                                                                        */
 /*    William E. Lamie, Microsoft Corporation                             */
 /*                                                                        */
 /*  DESCRIPTION                                                           */
 /*                                                                        */
-/*    This function sets up the extended NAND cache for block status,     */
-/*    page extra bytes, and page 0 contents. The routine will enable as   */
-/*    many cache capabilities as possible until the supplied memory is    */
-/*    exhausted.                                                          */
+/*    This function enables or disables the extended NAND cache. The      */
+/*    supplied memory is divided into page lists of one logical group     */
+/*    each, up to LX_NAND_EXTENDED_CACHE_SIZE entries. A page list holds  */
+/*    the latest page of every sector of a group that is mapped to a      */
+/*    non-sequential block, so the spare area of the block doesn't need   */
+/*    to be scanned to find a sector. The least recently used entry is    */
+/*    replaced when a new group is cached. Supplying no memory disables   */
+/*    the cache.                                                          */
 /*                                                                        */
 /*  INPUT                                                                 */
 /*                                                                        */
@@ -62,17 +66,96 @@
 /*                                                                        */
 /*    Completion Status                                                   */
 /*                                                                        */
+/*      LX_SUCCESS                          Cache enabled or disabled     */
+/*      LX_ERROR                            Flash not opened or memory    */
+/*                                            smaller than one page list  */
+/*      LX_NOT_SUPPORTED                    Cache compiled out            */
+/*                                                                        */
 /*  CALLS                                                                 */
 /*                                                                        */
-/*    None                                                                */
+/*    tx_mutex_get                          Get thread protection         */
+/*    tx_mutex_put                          Release thread protection     */
 /*                                                                        */
 /*  CALLED BY                                                             */
 /*                                                                        */
-/*    Internal LevelX                                                     */
+/*    Application Code                                                    */
 /*                                                                        */
 /**************************************************************************/
 UINT  _lx_nand_flash_extended_cache_enable(LX_NAND_FLASH  *nand_flash, VOID *memory, ULONG size)
 {
+#ifndef LX_NAND_DISABLE_EXTENDED_CACHE
+
+UINT        i;
+ULONG       entry_size;
+USHORT      *cache_memory;
+
+
+    /* Check if the NAND flash is opened.  */
+    if (nand_flash -> lx_nand_flash_state != LX_NAND_FLASH_OPENED)
+    {
+
+        /* The page lists are sized from the flash geometry, return an error.  */
+        return(LX_ERROR);
+    }
+
+    /* Calculate the size of one page list.  */
+    entry_size =  nand_flash -> lx_nand_flash_pages_per_block * sizeof(USHORT);
+
+    /* Determine if memory was specified but with an invalid size (less than one page list).  */
+    if ((memory) && (size < entry_size))
+    {
+
+        /* Error in memory size supplied.  */
+        return(LX_ERROR);
+    }
+
+#ifdef LX_THREAD_SAFE_ENABLE
+
+    /* Obtain the thread safe mutex.  */
+    tx_mutex_get(&nand_flash -> lx_nand_flash_mutex, TX_WAIT_FOREVER);
+#endif
+
+    /* Initialize the internal NAND cache.  */
+    nand_flash -> lx_nand_flash_extended_cache_entries =  0;
+    nand_flash -> lx_nand_flash_extended_cache_access_count =  0;
+
+    /* Setup cache memory pointer.  */
+    cache_memory =  (USHORT *) memory;
+
+    /* Loop through the memory supplied and assign to cache entries.  */
+    i =  0;
+    while ((memory) && (size >= entry_size) && (i < LX_NAND_EXTENDED_CACHE_SIZE))
+    {
+
+        /* Setup this cache entry, no logical group is cached yet.  */
+        nand_flash -> lx_nand_flash_extended_cache[i].lx_nand_flash_extended_cache_entry_page_list =  cache_memory;
+        nand_flash -> lx_nand_flash_extended_cache[i].lx_nand_flash_extended_cache_entry_logical_group =  LX_NAND_BLOCK_UNMAPPED;
+        nand_flash -> lx_nand_flash_extended_cache[i].lx_nand_flash_extended_cache_entry_block =  LX_NAND_BLOCK_UNMAPPED;
+        nand_flash -> lx_nand_flash_extended_cache[i].lx_nand_flash_extended_cache_entry_pages =  0;
+        nand_flash -> lx_nand_flash_extended_cache[i].lx_nand_flash_extended_cache_entry_access_count =  0;
+
+        /* Move the cache memory forward.   */
+        cache_memory =  cache_memory + nand_flash -> lx_nand_flash_pages_per_block;
+
+        /* Decrement the size.  */
+        size =  size - entry_size;
+
+        /* Move to next cache entry.  */
+        i++;
+    }
+
+    /* Save the number of cache entries.  */
+    nand_flash -> lx_nand_flash_extended_cache_entries =  i;
+
+#ifdef LX_THREAD_SAFE_ENABLE
+
+    /* Release the thread safe mutex.  */
+    tx_mutex_put(&nand_flash -> lx_nand_flash_mutex);
+#endif
+
+    /* Return successful completion.  */
+    return(LX_SUCCESS);
+#else
 
     LX_PARAMETER_NOT_USED(nand_flash);
     LX_PARAMETER_NOT_USED(memory);
@@ -80,5 +163,6 @@ UINT  _lx_nand_flash_extended_cache_enable(LX_NAND_FLASH  *nand_flash, VOID *mem
 
     /* Return not supported.  */
     return(LX_NOT_SUPPORTED);
+#endif
 }
 
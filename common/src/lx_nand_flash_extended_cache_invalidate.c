@@ -0,0 +1,106 @@
+/***************************************************************************
+ * Copyright (c) 2026-present Eclipse ThreadX contributors
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the MIT License which is available at
+ * https://opensource.org/licenses/MIT.
+ *
+ * SPDX-License-Identifier: MIT
+ **************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */
+/** LevelX Component                                                      */
+/**                                                                       */
+/**   NAND Flash                                                          */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+#define LX_SOURCE_CODE
+
+
+/* Disable ThreadX error checking.  */
+
+#ifndef LX_DISABLE_ERROR_CHECKING
+#define LX_DISABLE_ERROR_CHECKING
+#endif
+
+
+/* Include necessary system files.  */
+
+#include "lx_api.h"
+
+
+
+
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _lx_nand_flash_extended_cache_invalidate            PORTABLE C      */
+/*                                                           6.5.1        */
+/*  AUTHOR                                                                */
+/*                                                                        */
+/*    Eclipse ThreadX contributors                                        */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function drops the cached page list of a logical group. It is  */
+/*    called whenever the group is mapped to another block.               */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    nand_flash                            NAND flash instance           */
+/*    logical_group                         Logical group number          */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    return status                                                       */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    None                                                                */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    Internal LevelX                                                     */
+/*                                                                        */
+/**************************************************************************/
+UINT  _lx_nand_flash_extended_cache_invalidate(LX_NAND_FLASH *nand_flash, ULONG logical_group)
+{
+#ifndef LX_NAND_DISABLE_EXTENDED_CACHE
+
+UINT    i;
+
+
+    /* Loop through the cache entries to find the logical group.  */
+    for (i = 0; i < nand_flash -> lx_nand_flash_extended_cache_entries; i++)
+    {
+
+        /* Determine if this entry holds the logical group.  */
+        if (nand_flash -> lx_nand_flash_extended_cache[i].lx_nand_flash_extended_cache_entry_logical_group == logical_group)
+        {
+
+            /* Yes, mark the entry as empty.  */
+            nand_flash -> lx_nand_flash_extended_cache[i].lx_nand_flash_extended_cache_entry_logical_group =  LX_NAND_BLOCK_UNMAPPED;
+            nand_flash -> lx_nand_flash_extended_cache[i].lx_nand_flash_extended_cache_entry_block =  LX_NAND_BLOCK_UNMAPPED;
+            nand_flash -> lx_nand_flash_extended_cache[i].lx_nand_flash_extended_cache_entry_pages =  0;
+            nand_flash -> lx_nand_flash_extended_cache[i].lx_nand_flash_extended_cache_entry_access_count =  0;
+
+            /* A logical group is cached at most once.  */
+            break;
+        }
+    }
+#else
+
+    LX_PARAMETER_NOT_USED(nand_flash);
+    LX_PARAMETER_NOT_USED(logical_group);
+#endif
+
+    /* Return successful completion.  */
+    return(LX_SUCCESS);
+}
+
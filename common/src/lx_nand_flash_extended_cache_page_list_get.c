@@ -0,0 +1,271 @@
+/***************************************************************************
+ * Copyright (c) 2026-present Eclipse ThreadX contributors
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the MIT License which is available at
+ * https://opensource.org/licenses/MIT.
+ *
+ * SPDX-License-Identifier: MIT
+ **************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */
+/** LevelX Component                                                      */
+/**                                                                       */
+/**   NAND Flash                                                          */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+#define LX_SOURCE_CODE
+
+
+/* Disable ThreadX error checking.  */
+
+#ifndef LX_DISABLE_ERROR_CHECKING
+#define LX_DISABLE_ERROR_CHECKING
+#endif
+
+
+/* Include necessary system files.  */
+
+#include "lx_api.h"
+
+
+
+
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _lx_nand_flash_extended_cache_page_list_get         PORTABLE C      */
+/*                                                           6.5.1        */
+/*  AUTHOR                                                                */
+/*                                                                        */
+/*    Eclipse ThreadX contributors                                        */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function returns the cached page list of a logical group that  */
+/*    is mapped to a non-sequential block. Each entry of the list holds   */
+/*    the latest page of a sector of the group, with LX_NAND_SECTOR_PAGE_ */
+/*    RELEASED set if the sector has been released, or LX_NAND_SECTOR_    */
+/*    PAGE_NOT_FOUND if the sector is not in the block.                   */
+/*                                                                        */
+/*    If the group is not cached, the least recently used entry is        */
+/*    replaced and the spare areas of the block are scanned once from     */
+/*    the first page. Otherwise only the pages written since the list was */
+/*    last updated are scanned.                                           */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    nand_flash                            NAND flash instance           */
+/*    logical_group                         Logical group number          */
+/*    block                                 Block mapped to the group     */
+/*    block_status                          Block status                  */
+/*    page_list                             Pointer to return page list   */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    return status                                                       */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    lx_nand_flash_driver_pages_read       Read pages                    */
+/*    _lx_nand_flash_system_error           Internal system error handler */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    Internal LevelX                                                     */
+/*                                                                        */
+/**************************************************************************/
+UINT  _lx_nand_flash_extended_cache_page_list_get(LX_NAND_FLASH *nand_flash, ULONG logical_group, ULONG block, USHORT block_status, USHORT **page_list)
+{
+#ifndef LX_NAND_DISABLE_EXTENDED_CACHE
+
+UINT                                status;
+UINT                                i;
+UINT                                least_used_cache_entry;
+ULONG                               available_pages;
+ULONG                               pages_per_read;
+ULONG                               start_page;
+ULONG                               pages;
+ULONG                               page;
+ULONG                               spare_data1;
+ULONG                               logical_sector;
+UCHAR                               *spare_buffer_ptr;
+LX_NAND_FLASH_EXTENDED_CACHE_ENTRY  *cache_entry;
+
+
+    /* Determine if the cache is enabled.  */
+    if (nand_flash -> lx_nand_flash_extended_cache_entries == 0)
+    {
+
+        /* Return disabled.  */
+        return(LX_DISABLED);
+    }
+
+    /* Get available pages in this block.  */
+    available_pages = (block_status & LX_NAND_BLOCK_STATUS_FULL) ? nand_flash -> lx_nand_flash_pages_per_block : (block_status & LX_NAND_BLOCK_STATUS_PAGE_NUMBER_MASK);
+
+    /* Increment the access count.  */
+    nand_flash -> lx_nand_flash_extended_cache_access_count++;
+
+    /* Initialize the least used cache entry.  */
+    least_used_cache_entry =  0;
+    cache_entry =  LX_NULL;
+
+    /* Loop through the cache entries to see if the logical group is in cache.  */
+    for (i = 0; i < nand_flash -> lx_nand_flash_extended_cache_entries; i++)
+    {
+
+        /* Determine if this entry holds the logical group.  */
+        if (nand_flash -> lx_nand_flash_extended_cache[i].lx_nand_flash_extended_cache_entry_logical_group == logical_group)
+        {
+
+            /* Yes, we found the entry.  */
+            cache_entry =  &nand_flash -> lx_nand_flash_extended_cache[i];
+            break;
+        }
+
+        /* Determine if this entry was used less recently.  */
+        if (nand_flash -> lx_nand_flash_extended_cache[i].lx_nand_flash_extended_cache_entry_access_count <
+            nand_flash -> lx_nand_flash_extended_cache[least_used_cache_entry].lx_nand_flash_extended_cache_entry_access_count)
+        {
+
+            /* New least used entry.  */
+            least_used_cache_entry =  i;
+        }
+    }
+
+    /* Determine if the logical group is cached for this block.  */
+    if ((cache_entry != LX_NULL) &&
+        (cache_entry -> lx_nand_flash_extended_cache_entry_block == block) &&
+        (cache_entry -> lx_nand_flash_extended_cache_entry_pages <= available_pages))
+    {
+
+        /* Increment the number of cache hits.  */
+        nand_flash -> lx_nand_flash_extended_cache_hits++;
+    }
+    else
+    {
+
+        /* Determine if the logical group is not cached.  */
+        if (cache_entry == LX_NULL)
+        {
+
+            /* Replace the least used entry.  */
+            cache_entry =  &nand_flash -> lx_nand_flash_extended_cache[least_used_cache_entry];
+        }
+
+        /* Setup the cache entry for the block.  */
+        cache_entry -> lx_nand_flash_extended_cache_entry_logical_group =  logical_group;
+        cache_entry -> lx_nand_flash_extended_cache_entry_block =  block;
+        cache_entry -> lx_nand_flash_extended_cache_entry_pages =  0;
+
+        /* Clear the page list.  */
+        LX_MEMSET(cache_entry -> lx_nand_flash_extended_cache_entry_page_list, 0xFF, nand_flash -> lx_nand_flash_pages_per_block * sizeof(USHORT));
+
+        /* Increment the number of cache misses.  */
+        nand_flash -> lx_nand_flash_extended_cache_misses++;
+    }
+
+    /* Update the access count of the entry.  */
+    cache_entry -> lx_nand_flash_extended_cache_entry_access_count =  nand_flash -> lx_nand_flash_extended_cache_access_count;
+
+    /* Setup spare buffer pointer.  */
+    spare_buffer_ptr = nand_flash -> lx_nand_flash_page_buffer;
+
+    /* Calculate the number of spare areas to read in one driver call.  */
+    pages_per_read = (nand_flash -> lx_nand_flash_bytes_per_page + nand_flash -> lx_nand_flash_spare_total_length) / nand_flash -> lx_nand_flash_spare_total_length;
+
+    /* Loop to scan the pages not in the page list yet.  */
+    start_page = cache_entry -> lx_nand_flash_extended_cache_entry_pages;
+    while (start_page < available_pages)
+    {
+
+        /* Calculate the pages to read.  */
+        pages = ((available_pages - start_page) > pages_per_read) ? pages_per_read : (available_pages - start_page);
+
+        /* Read the spare data of the pages.  */
+#ifdef LX_NAND_ENABLE_CONTROL_BLOCK_FOR_DRIVER_INTERFACE
+        status = (nand_flash -> lx_nand_flash_driver_pages_read)(nand_flash, block, start_page, LX_NULL, spare_buffer_ptr, pages);
+#else
+        status = (nand_flash -> lx_nand_flash_driver_pages_read)(block, start_page, LX_NULL, spare_buffer_ptr, pages);
+#endif
+
+        /* Check for an error from flash driver.   */
+        if (status)
+        {
+
+            /* Drop the partially built entry.  */
+            cache_entry -> lx_nand_flash_extended_cache_entry_logical_group =  LX_NAND_BLOCK_UNMAPPED;
+            cache_entry -> lx_nand_flash_extended_cache_entry_block =  LX_NAND_BLOCK_UNMAPPED;
+            cache_entry -> lx_nand_flash_extended_cache_entry_pages =  0;
+
+            /* Call system error handler.  */
+            _lx_nand_flash_system_error(nand_flash, status, block, 0);
+
+            /* Return an error.  */
+            return(LX_ERROR);
+        }
+
+        /* Loop to record the pages in order, a later page of a sector takes priority.  */
+        for (page = 0; page < pages; page++)
+        {
+
+            /* Get the spare data.  */
+            spare_data1 = LX_UTILITY_LONG_GET(&spare_buffer_ptr[page * nand_flash -> lx_nand_flash_spare_total_length + nand_flash -> lx_nand_flash_spare_data1_offset]);
+
+            /* Get the logical sector.  */
+            logical_sector = spare_data1 & LX_NAND_PAGE_TYPE_USER_DATA_MASK;
+
+            /* Check if the page holds a sector of this logical group.  */
+            if ((logical_sector / nand_flash -> lx_nand_flash_pages_per_block) == logical_group)
+            {
+
+                /* Check the page type.  */
+                if ((spare_data1 & ~LX_NAND_PAGE_TYPE_USER_DATA_MASK) == LX_NAND_PAGE_TYPE_USER_DATA)
+                {
+
+                    /* Set the page number.  */
+                    cache_entry -> lx_nand_flash_extended_cache_entry_page_list[logical_sector % nand_flash -> lx_nand_flash_pages_per_block] =
+                                                                                    (USHORT)(start_page + page);
+                }
+                else if ((spare_data1 & ~LX_NAND_PAGE_TYPE_USER_DATA_MASK) == LX_NAND_PAGE_TYPE_USER_DATA_RELEASED)
+                {
+
+                    /* Set the page number with the released flag.  */
+                    cache_entry -> lx_nand_flash_extended_cache_entry_page_list[logical_sector % nand_flash -> lx_nand_flash_pages_per_block] =
+                                                                                    (USHORT)((start_page + page) | LX_NAND_SECTOR_PAGE_RELEASED);
+                }
+            }
+        }
+
+        /* Move to the next pages.  */
+        start_page = start_page + pages;
+    }
+
+    /* Update the pages in the page list.  */
+    cache_entry -> lx_nand_flash_extended_cache_entry_pages =  available_pages;
+
+    /* Return the page list.  */
+    *page_list =  cache_entry -> lx_nand_flash_extended_cache_entry_page_list;
+
+    /* Return successful completion.  */
+    return(LX_SUCCESS);
+#else
+
+    LX_PARAMETER_NOT_USED(nand_flash);
+    LX_PARAMETER_NOT_USED(logical_group);
+    LX_PARAMETER_NOT_USED(block);
+    LX_PARAMETER_NOT_USED(block_status);
+    LX_PARAMETER_NOT_USED(page_list);
+
+    /* Return disabled.  */
+    return(LX_DISABLED);
+#endif
+}
+
@@ -77,6 +77,7 @@
 /*                                          Driver block status set       */
 /*    _lx_nand_flash_metadata_build         Build metadata                */
 /*    _lx_nand_flash_metadata_write         Write metadata                */
+/*    _lx_nand_flash_anchor_write           Write the mount anchor        */
 /*    _lx_nand_flash_driver_block_erase     Driver block erase            */
 /*    _lx_nand_flash_system_error           System error handler          */
 /*    tx_mutex_create                       Create thread-safe mutex      */
@@ -95,6 +96,9 @@ ULONG                       block;
 UCHAR                       block_status;
 UINT                        status;
 UCHAR                       *page_buffer_ptr;
+#ifndef LX_NAND_DISABLE_FAST_MOUNT
+UINT                        anchor_count;
+#endif
 
     LX_PARAMETER_NOT_USED(name);
 
@@ -145,6 +149,15 @@ UCHAR                       *page_buffer_ptr;
 
     /* Initialize the block status buffer.  */
     LX_MEMSET(nand_flash -> lx_nand_flash_block_status_table, 0xFF, nand_flash -> lx_nand_flash_block_status_table_size);
+#ifndef LX_NAND_DISABLE_FAST_MOUNT
+
+    /* Loop to initialize the anchor blocks.  */
+    for (anchor_count = 0; anchor_count < LX_NAND_ANCHOR_BLOCKS; anchor_count++)
+    {
+        nand_flash -> lx_nand_flash_anchor_block[anchor_count] = LX_NAND_BLOCK_UNMAPPED;
+    }
+    anchor_count = 0;
+#endif
 
     /* Loop through the blocks to check for bad blocks and determine the minimum and maximum erase count for each good block.  */
     for (block = 0; block < nand_flash -> lx_nand_flash_total_blocks; block++)
@@ -209,6 +222,21 @@ UCHAR                       *page_buffer_ptr;
         }
         else
         {
+#ifndef LX_NAND_DISABLE_FAST_MOUNT
+
+            /* Reserve the first good blocks for the mount anchor.  */
+            if (anchor_count < LX_NAND_ANCHOR_BLOCKS)
+            {
+
+                /* Save the anchor block.  */
+                nand_flash -> lx_nand_flash_anchor_block[anchor_count] = (USHORT)block;
+                nand_flash -> lx_nand_flash_block_status_table[block] = LX_NAND_BLOCK_STATUS_ANCHOR;
+                anchor_count++;
+
+                /* Continue to the next block.  */
+                continue;
+            }
+#endif
 
             /* Allocate blocks for metadata.  */
             if (nand_flash -> lx_nand_flash_metadata_block_number == LX_NAND_BLOCK_UNMAPPED)
@@ -274,6 +302,15 @@ UCHAR                       *page_buffer_ptr;
         return(status);
     }
 
+    /* Write the anchor. The new metadata needs no recovery at open.  */
+    status = _lx_nand_flash_anchor_write(nand_flash, LX_NAND_ANCHOR_STATE_CLEAN);
+
+    if (status != LX_SUCCESS)
+    {
+        /* Return error status.  */
+        return(status);
+    }
+
     /* Return a successful completion.  */
     return(LX_SUCCESS);
 }
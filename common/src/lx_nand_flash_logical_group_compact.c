@@ -195,9 +195,9 @@ UCHAR   *spare_buffer_ptr;
 /*  CALLED BY                                                             */
 /*                                                                        */
 /*    _lx_nand_flash_sector_release         Lazy release pre-compact      */
-/*    _lx_nand_flash_sector_write           Pre-compact before block copy */
+/*    _lx_nand_flash_logical_group_write    Pre-compact before block copy */
 /*    _lx_nand_flash_block_data_move        Wear-level with pending compact*/
-/*    _lx_nand_flash_defragment             Explicit defragment pass      */
+/*    _lx_nand_flash_partial_defragment     Explicit defragment pass      */
 /*    _lx_nand_flash_block_allocate         Emergency compaction          */
 /*                                                                        */
 /**************************************************************************/
@@ -0,0 +1,342 @@
+/***************************************************************************
+ * Copyright (c) 2026-present Eclipse ThreadX contributors
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the MIT License which is available at
+ * https://opensource.org/licenses/MIT.
+ *
+ * SPDX-License-Identifier: MIT
+ **************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */
+/** LevelX Component                                                      */
+/**                                                                       */
+/**   NAND Flash                                                          */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+#define LX_SOURCE_CODE
+
+
+/* Disable ThreadX error checking.  */
+
+#ifndef LX_DISABLE_ERROR_CHECKING
+#define LX_DISABLE_ERROR_CHECKING
+#endif
+
+
+/* Include necessary system files.  */
+
+#include "lx_api.h"
+
+
+
+
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _lx_nand_flash_logical_group_consolidate            PORTABLE C      */
+/*                                                           6.5.1        */
+/*  AUTHOR                                                                */
+/*                                                                        */
+/*    Eclipse ThreadX contributors                                        */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function rewrites the non-sequential block of a logical group  */
+/*    into a new block that holds only the latest data page of each       */
+/*    sector, in sector order. The old block is then erased and freed.    */
+/*    A group whose sectors are all released is unmapped instead.         */
+/*                                                                        */
+/*    Nothing is done if the block has neither superseded nor released    */
+/*    pages and its sectors can't be made sequential, or if a compaction  */
+/*    is pending for the group.                                           */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    nand_flash                            NAND flash instance           */
+/*    logical_group                         Logical group number          */
+/*    consolidated                          Pointer to return LX_TRUE if  */
+/*                                            the group was rewritten     */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    return status                                                       */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    _lx_nand_flash_sector_pages_find      Find pages of sectors         */
+/*    _lx_nand_flash_block_allocate         Allocate block                */
+/*    _lx_nand_flash_mapped_block_list_remove                             */
+/*                                          Remove mapped block           */
+/*    _lx_nand_flash_data_page_copy         Copy data pages               */
+/*    _lx_nand_flash_block_status_set       Set block status              */
+/*    _lx_nand_flash_block_mapping_set      Set block mapping             */
+/*    _lx_nand_flash_driver_block_erase     Erase block                   */
+/*    _lx_nand_flash_erase_count_set        Set erase count               */
+/*    _lx_nand_flash_block_data_move        Move block data               */
+/*    _lx_nand_flash_free_block_list_add    Add free block to list        */
+/*    _lx_nand_flash_mapped_block_list_add  Add mapped block to list      */
+/*    _lx_nand_flash_system_error           Internal system error handler */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    Internal LevelX                                                     */
+/*                                                                        */
+/**************************************************************************/
+UINT  _lx_nand_flash_logical_group_consolidate(LX_NAND_FLASH *nand_flash, ULONG logical_group, UINT *consolidated)
+{
+
+UINT        status;
+ULONG       block;
+USHORT      block_status;
+ULONG       new_block = LX_NAND_BLOCK_UNMAPPED;
+USHORT      new_block_status = LX_NAND_BLOCK_STATUS_ALLOCATED;
+ULONG       pages_per_block;
+ULONG       available_pages;
+ULONG       live_sectors;
+UINT        sequential;
+ULONG       sector_offset;
+ULONG       sectors;
+ULONG       i;
+USHORT      *page_list;
+
+
+    /* Nothing is consolidated yet.  */
+    *consolidated = LX_FALSE;
+
+    /* Get the block of the logical group.  */
+    block = nand_flash -> lx_nand_flash_block_mapping_table[logical_group];
+
+    /* Check if the group is mapped to a non-sequential block.  */
+    if ((block == LX_NAND_BLOCK_UNMAPPED) ||
+        ((nand_flash -> lx_nand_flash_block_status_table[block] & LX_NAND_BLOCK_STATUS_NON_SEQUENTIAL) == 0))
+    {
+
+        /* Nothing to do.  */
+        return(LX_SUCCESS);
+    }
+
+#ifdef LX_NAND_FLASH_ENABLE_LAZY_SECTOR_RELEASE
+
+    /* Sectors of the group may still live in the compaction block, leave the group to the compaction.  */
+    if (nand_flash -> lx_nand_flash_block_compaction_table[logical_group] != (USHORT)LX_NAND_BLOCK_UNMAPPED)
+    {
+
+        /* Nothing to do.  */
+        return(LX_SUCCESS);
+    }
+#endif
+
+    /* Get the block status.  */
+    block_status = nand_flash -> lx_nand_flash_block_status_table[block];
+
+    /* Pick up pages per block.  */
+    pages_per_block = nand_flash -> lx_nand_flash_pages_per_block;
+
+    /* Get available pages in this block.  */
+    available_pages = (block_status & LX_NAND_BLOCK_STATUS_FULL) ? pages_per_block : (block_status & LX_NAND_BLOCK_STATUS_PAGE_NUMBER_MASK);
+
+    /* Setup the page list.  */
+    page_list = nand_flash -> lx_nand_flash_sector_page_list;
+
+    /* Count the sectors with valid data and check if they are the first sectors of the group.  */
+    live_sectors = 0;
+    sequential = LX_TRUE;
+    for (sector_offset = 0; sector_offset < pages_per_block; sector_offset += sectors)
+    {
+
+        /* Calculate the sectors to find in this pass.  */
+        sectors = pages_per_block - sector_offset;
+        if (sectors > nand_flash -> lx_nand_flash_sector_page_list_size)
+        {
+            sectors = nand_flash -> lx_nand_flash_sector_page_list_size;
+        }
+
+        /* Find the pages of the sectors.  */
+        LX_MEMSET(page_list, 0xFF, sectors * sizeof(USHORT));
+        status = _lx_nand_flash_sector_pages_find(nand_flash, block, block_status, logical_group * pages_per_block + sector_offset, sectors, page_list);
+
+        /* Check return status.  */
+        if (status)
+        {
+
+            /* Return an error.  */
+            return(LX_ERROR);
+        }
+
+        /* Loop to check the pages.  */
+        for (i = 0; i < sectors; i++)
+        {
+
+            /* Check if the sector has valid data.  */
+            if ((page_list[i] != LX_NAND_SECTOR_PAGE_NOT_FOUND) && ((page_list[i] & LX_NAND_SECTOR_PAGE_RELEASED) == 0))
+            {
+
+                /* The sectors are not sequential if there is a gap before this one.  */
+                if (live_sectors != sector_offset + i)
+                {
+                    sequential = LX_FALSE;
+                }
+
+                /* Increment the number of sectors with valid data.  */
+                live_sectors++;
+            }
+        }
+    }
+
+    /* Check if there is nothing to reclaim and the block can't become sequential.  */
+    if ((live_sectors == available_pages) && (sequential == LX_FALSE))
+    {
+
+        /* Nothing to do.  */
+        return(LX_SUCCESS);
+    }
+
+    /* Check if there is any sector to keep.  */
+    if (live_sectors)
+    {
+
+        /* Allocate a new block.  */
+        status = _lx_nand_flash_block_allocate(nand_flash, &new_block);
+
+        /* Check if there is no blocks.  */
+        if (status == LX_NO_BLOCKS)
+        {
+
+            /* Return error.  */
+            return(status);
+        }
+
+        /* Check return status.  */
+        else if (status != LX_SUCCESS)
+        {
+
+            /* Call system error handler.  */
+            _lx_nand_flash_system_error(nand_flash, status, new_block, 0);
+
+            /* Determine if the error is fatal.  */
+            if (status != LX_NAND_ERROR_CORRECTED)
+            {
+
+                /* Return an error.  */
+                return(LX_ERROR);
+            }
+        }
+    }
+
+    /* Remove the old block from mapped block list.  */
+    _lx_nand_flash_mapped_block_list_remove(nand_flash, logical_group);
+
+    /* Check if there is any sector to keep.  */
+    if (live_sectors)
+    {
+
+        /* Copy valid sectors to the new block.  */
+        status = _lx_nand_flash_data_page_copy(nand_flash, logical_group * pages_per_block, block, block_status, new_block, &new_block_status, pages_per_block);
+
+        /* Check for an error from flash driver.   */
+        if (status)
+        {
+
+            /* Call system error handler.  */
+            _lx_nand_flash_system_error(nand_flash, status, block, 0);
+
+            /* Return an error.  */
+            return(LX_ERROR);
+        }
+
+        /* Set new block status.  */
+        status = _lx_nand_flash_block_status_set(nand_flash, new_block, new_block_status);
+
+        /* Check for an error from flash driver.   */
+        if (status)
+        {
+
+            /* Call system error handler.  */
+            _lx_nand_flash_system_error(nand_flash, status, new_block, 0);
+
+            /* Return an error.  */
+            return(LX_ERROR);
+        }
+    }
+
+    /* Update block mapping.  */
+    _lx_nand_flash_block_mapping_set(nand_flash, logical_group * pages_per_block, new_block);
+
+    /* Erase old block.  */
+    status = _lx_nand_flash_driver_block_erase(nand_flash, block, nand_flash -> lx_nand_flash_base_erase_count + nand_flash -> lx_nand_flash_erase_count_table[block] + 1);
+
+    /* Check for an error from flash driver.   */
+    if (status)
+    {
+
+        /* Call system error handler.  */
+        _lx_nand_flash_system_error(nand_flash, status, block, 0);
+
+        /* Return an error.  */
+        return(LX_ERROR);
+    }
+
+    /* Update erase count for the old block.  */
+    status = _lx_nand_flash_erase_count_set(nand_flash, block, (UCHAR)(nand_flash -> lx_nand_flash_erase_count_table[block] + 1));
+
+    /* Check for an error from flash driver.   */
+    if (status)
+    {
+
+        /* Call system error handler.  */
+        _lx_nand_flash_system_error(nand_flash, status, block, 0);
+
+        /* Return an error.  */
+        return(LX_ERROR);
+    }
+
+    /* Check if the block has too many erases.  */
+    if (nand_flash -> lx_nand_flash_erase_count_table[block] > LX_NAND_FLASH_MAX_ERASE_COUNT_DELTA)
+    {
+
+        /* Move data from less worn block.  */
+        _lx_nand_flash_block_data_move(nand_flash, block);
+    }
+    else
+    {
+
+        /* Set the block status to free.  */
+        status = _lx_nand_flash_block_status_set(nand_flash, block, LX_NAND_BLOCK_STATUS_FREE);
+
+        /* Check for an error from flash driver.   */
+        if (status)
+        {
+
+            /* Call system error handler.  */
+            _lx_nand_flash_system_error(nand_flash, status, block, 0);
+
+            /* Return an error.  */
+            return(LX_ERROR);
+        }
+
+        /* Add the block to free block list.  */
+        _lx_nand_flash_free_block_list_add(nand_flash, block);
+    }
+
+    /* Check if there is any sector to keep.  */
+    if (live_sectors)
+    {
+
+        /* Add the new block to mapped block list.  */
+        _lx_nand_flash_mapped_block_list_add(nand_flash, logical_group);
+    }
+
+    /* The group has been consolidated.  */
+    *consolidated = LX_TRUE;
+
+    /* Return successful completion.  */
+    return(LX_SUCCESS);
+}
+
@@ -0,0 +1,316 @@
+/***************************************************************************
+ * Copyright (c) 2026-present Eclipse ThreadX contributors
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the MIT License which is available at
+ * https://opensource.org/licenses/MIT.
+ *
+ * SPDX-License-Identifier: MIT
+ **************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */
+/** LevelX Component                                                      */
+/**                                                                       */
+/**   NAND Flash                                                          */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+#define LX_SOURCE_CODE
+
+
+/* Disable ThreadX error checking.  */
+
+#ifndef LX_DISABLE_ERROR_CHECKING
+#define LX_DISABLE_ERROR_CHECKING
+#endif
+
+
+/* Include necessary system files.  */
+
+#include "lx_api.h"
+
+
+
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _lx_nand_flash_logical_group_pages_read             PORTABLE C      */
+/*                                                           6.5.1        */
+/*  AUTHOR                                                                */
+/*                                                                        */
+/*    Eclipse ThreadX contributors                                        */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This helper reads the sectors found in a block. Sectors stored in   */
+/*    consecutive pages are read with one driver call and released        */
+/*    sectors are filled with ones. The page list entries of the sectors  */
+/*    read are set to LX_NAND_SECTOR_PAGE_RESOLVED.                       */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    nand_flash                            NAND flash instance           */
+/*    block                                 Block number                  */
+/*    buffer                                Pointer to buffer to read into*/
+/*    sector_count                          Number of sectors             */
+/*    page_list                             Page list of the sectors      */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    return status                                                       */
+/*                                                                        */
+/**************************************************************************/
+static UINT  _lx_nand_flash_logical_group_pages_read(LX_NAND_FLASH *nand_flash, ULONG block, UCHAR *buffer, ULONG sector_count, USHORT *page_list)
+{
+
+UINT        status;
+ULONG       i;
+ULONG       j;
+ULONG       pages;
+USHORT      page;
+
+
+    /* Loop through the sectors.  */
+    for (i = 0; i < sector_count; i += pages)
+    {
+
+        /* Pickup the page of the sector.  */
+        page = page_list[i];
+        pages = 1;
+
+        /* Check if the sector is found in this block.  */
+        if ((page == LX_NAND_SECTOR_PAGE_NOT_FOUND) || (page == LX_NAND_SECTOR_PAGE_RESOLVED))
+        {
+            continue;
+        }
+
+        /* Check if the sector is released.  */
+        if (page & LX_NAND_SECTOR_PAGE_RELEASED)
+        {
+
+            /* A released sector reads as all ones.  */
+            LX_MEMSET(buffer + i * nand_flash -> lx_nand_flash_bytes_per_page, 0xFF, nand_flash -> lx_nand_flash_bytes_per_page);
+        }
+        else
+        {
+
+            /* Find the following sectors stored in consecutive pages.  */
+            while ((i + pages < sector_count) && (page_list[i + pages] == page + pages))
+            {
+                pages++;
+            }
+
+            /* Read the pages.  */
+#ifdef LX_NAND_ENABLE_CONTROL_BLOCK_FOR_DRIVER_INTERFACE
+            status = (nand_flash -> lx_nand_flash_driver_pages_read)(nand_flash, block, page, buffer + i * nand_flash -> lx_nand_flash_bytes_per_page, LX_NULL, pages);
+#else
+            status = (nand_flash -> lx_nand_flash_driver_pages_read)(block, page, buffer + i * nand_flash -> lx_nand_flash_bytes_per_page, LX_NULL, pages);
+#endif
+
+            /* Check for an error from flash driver.   */
+            if (status)
+            {
+
+                /* Call system error handler.  */
+                _lx_nand_flash_system_error(nand_flash, status, block, 0);
+
+                /* Return an error.  */
+                return(LX_ERROR);
+            }
+        }
+
+        /* Mark the sectors as resolved.  */
+        for (j = i; j < i + pages; j++)
+        {
+            page_list[j] = LX_NAND_SECTOR_PAGE_RESOLVED;
+        }
+    }
+
+    /* Return successful completion.  */
+    return(LX_SUCCESS);
+}
+
+
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _lx_nand_flash_logical_group_read                   PORTABLE C      */
+/*                                                           6.5.1        */
+/*  AUTHOR                                                                */
+/*                                                                        */
+/*    Eclipse ThreadX contributors                                        */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function reads a run of consecutive logical sectors that all   */
+/*    belong to the same logical group. The mapped block is found once,   */
+/*    the pages of the sectors are found with one pass over the block and */
+/*    sectors in consecutive pages are read with one driver call. Sectors */
+/*    that have not been written are filled with ones.                    */
+/*                                                                        */
+/*    The caller is responsible for thread protection.                    */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    nand_flash                            NAND flash instance           */
+/*    logical_sector                        First logical sector          */
+/*    buffer                                Pointer to buffer to read into*/
+/*                                            (the size is number of      */
+/*                                             bytes in a page times      */
+/*                                             sector count)              */
+/*    sector_count                          Number of sectors to read,    */
+/*                                            must not cross the logical  */
+/*                                            group boundary              */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    return status                                                       */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    _lx_nand_flash_block_find             Find the mapped block         */
+/*    _lx_nand_flash_sector_pages_find      Find pages of sectors         */
+/*    _lx_nand_flash_logical_group_pages_read                             */
+/*                                          Read pages of sectors         */
+/*    _lx_nand_flash_system_error           Internal system error handler */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    _lx_nand_flash_sector_read                                          */
+/*    _lx_nand_flash_sectors_read                                         */
+/*                                                                        */
+/**************************************************************************/
+UINT  _lx_nand_flash_logical_group_read(LX_NAND_FLASH *nand_flash, ULONG logical_sector, UCHAR *buffer, ULONG sector_count)
+{
+
+UINT        status;
+ULONG       i;
+ULONG       sectors;
+ULONG       block;
+USHORT      block_status;
+USHORT      *page_list;
+#ifdef LX_NAND_FLASH_ENABLE_LAZY_SECTOR_RELEASE
+ULONG       old_block;
+#endif
+
+
+    /* See if we can find the sector in the current mapping.  */
+    status = _lx_nand_flash_block_find(nand_flash, logical_sector, &block, &block_status);
+
+    /* Check return status.   */
+    if (status != LX_SUCCESS)
+    {
+
+        /* Call system error handler.  */
+        _lx_nand_flash_system_error(nand_flash, status, block, 0);
+
+        /* Determine if the error is fatal.  */
+        if (status != LX_NAND_ERROR_CORRECTED)
+        {
+
+            /* Return an error.  */
+            return(LX_ERROR);
+        }
+    }
+
+    /* Setup page list pointer.  */
+    page_list = nand_flash -> lx_nand_flash_sector_page_list;
+
+    /* Loop to read the sectors, as many as the page list holds at a time.  */
+    while (sector_count)
+    {
+
+        /* Calculate the sectors of this pass.  */
+        sectors = (sector_count > nand_flash -> lx_nand_flash_sector_page_list_size) ? nand_flash -> lx_nand_flash_sector_page_list_size : sector_count;
+
+        /* Clear the page list.  */
+        for (i = 0; i < sectors; i++)
+        {
+            page_list[i] = LX_NAND_SECTOR_PAGE_NOT_FOUND;
+        }
+
+        /* Determine if the block is mapped.  */
+        if (block != LX_NAND_BLOCK_UNMAPPED)
+        {
+
+            /* Find the pages of the sectors.  */
+            status = _lx_nand_flash_sector_pages_find(nand_flash, block, block_status, logical_sector, sectors, page_list);
+
+            /* Check for an error.  */
+            if (status == LX_SUCCESS)
+            {
+
+                /* Read the sectors found in the block.  */
+                status = _lx_nand_flash_logical_group_pages_read(nand_flash, block, buffer, sectors, page_list);
+            }
+
+            /* Check for an error.  */
+            if (status)
+            {
+
+                /* Return an error.  */
+                return(LX_ERROR);
+            }
+        }
+
+#ifdef LX_NAND_FLASH_ENABLE_LAZY_SECTOR_RELEASE
+
+        /* Check the compaction table for a deferred source block that might hold
+           the remaining sectors.  The primary block (tombstone block) was already
+           scanned above; fall back to the old full block here.  */
+        old_block = nand_flash -> lx_nand_flash_block_compaction_table[logical_sector / nand_flash -> lx_nand_flash_pages_per_block];
+
+        if (old_block != (USHORT)LX_NAND_BLOCK_UNMAPPED)
+        {
+
+            /* The compaction-pending block is always FULL; scan all pages in reverse.  */
+            status = _lx_nand_flash_sector_pages_find(nand_flash, old_block, LX_NAND_BLOCK_STATUS_FULL | LX_NAND_BLOCK_STATUS_NON_SEQUENTIAL,
+                                                      logical_sector, sectors, page_list);
+
+            /* Check for an error.  */
+            if (status == LX_SUCCESS)
+            {
+
+                /* Read the sectors found in the block.  */
+                status = _lx_nand_flash_logical_group_pages_read(nand_flash, old_block, buffer, sectors, page_list);
+            }
+
+            /* Check for an error.  */
+            if (status)
+            {
+
+                /* Return an error.  */
+                return(LX_ERROR);
+            }
+        }
+#endif /* LX_NAND_FLASH_ENABLE_LAZY_SECTOR_RELEASE */
+
+        /* Loop to fill the sectors that haven't been written with ones.  */
+        for (i = 0; i < sectors; i++)
+        {
+
+            /* Check if the sector is found.  */
+            if (page_list[i] == LX_NAND_SECTOR_PAGE_NOT_FOUND)
+            {
+
+                /* Put all ones in the buffer.  */
+                LX_MEMSET(buffer + i * nand_flash -> lx_nand_flash_bytes_per_page, 0xFF, nand_flash -> lx_nand_flash_bytes_per_page);
+            }
+        }
+
+        /* Move to the next sectors.  */
+        logical_sector += sectors;
+        buffer += sectors * nand_flash -> lx_nand_flash_bytes_per_page;
+        sector_count -= sectors;
+    }
+
+    /* Return successful completion.  */
+    return(LX_SUCCESS);
+}
+
@@ -0,0 +1,441 @@
+/***************************************************************************
+ * Copyright (c) 2026-present Eclipse ThreadX contributors
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the MIT License which is available at
+ * https://opensource.org/licenses/MIT.
+ *
+ * SPDX-License-Identifier: MIT
+ **************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */
+/** LevelX Component                                                      */
+/**                                                                       */
+/**   NAND Flash                                                          */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+#define LX_SOURCE_CODE
+
+
+/* Disable ThreadX error checking.  */
+
+#ifndef LX_DISABLE_ERROR_CHECKING
+#define LX_DISABLE_ERROR_CHECKING
+#endif
+
+
+/* Include necessary system files.  */
+
+#include "lx_api.h"
+
+
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _lx_nand_flash_logical_group_write                  PORTABLE C      */
+/*                                                           6.5.1        */
+/*  AUTHOR                                                                */
+/*                                                                        */
+/*    Eclipse ThreadX contributors                                        */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function writes a run of consecutive logical sectors that all  */
+/*    belong to the same logical group. If the mapped block has room for  */
+/*    the whole run, the pages are appended to it. Otherwise a new block  */
+/*    is allocated, the valid sectors before and after the run are copied */
+/*    around it and the old block is erased. Pages are written with as    */
+/*    few driver calls as the page buffer allows and the block status is  */
+/*    committed once for the run.                                         */
+/*                                                                        */
+/*    The caller is responsible for thread protection.                    */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    nand_flash                            NAND flash instance           */
+/*    logical_sector                        First logical sector          */
+/*    buffer                                Pointer to buffer to write    */
+/*                                            (the size is number of      */
+/*                                             bytes in a page times      */
+/*                                             sector count)              */
+/*    sector_count                          Number of sectors to write,   */
+/*                                            must not cross the logical  */
+/*                                            group boundary              */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    return status                                                       */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    _lx_nand_flash_block_find             Find the mapped block         */
+/*    _lx_nand_flash_logical_group_compact  Complete pending compaction   */
+/*    _lx_nand_flash_block_allocate         Allocate block                */
+/*    _lx_nand_flash_mapped_block_list_remove                             */
+/*                                          Remove mapped block           */
+/*    _lx_nand_flash_data_page_copy         Copy data pages               */
+/*    _lx_nand_flash_free_block_list_add    Add free block to list        */
+/*    _lx_nand_flash_block_mapping_set      Set block mapping             */
+/*    lx_nand_flash_driver_pages_write      Write pages                   */
+/*    _lx_nand_flash_block_status_set       Set block status              */
+/*    _lx_nand_flash_driver_block_erase     Erase block                   */
+/*    _lx_nand_flash_erase_count_set        Set erase count               */
+/*    _lx_nand_flash_block_data_move        Move block data               */
+/*    _lx_nand_flash_mapped_block_list_add  Add mapped block to list      */
+/*    _lx_nand_flash_system_error           Internal system error handler */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    _lx_nand_flash_sector_write                                         */
+/*    _lx_nand_flash_sectors_write                                        */
+/*                                                                        */
+/**************************************************************************/
+UINT  _lx_nand_flash_logical_group_write(LX_NAND_FLASH *nand_flash, ULONG logical_sector, UCHAR *buffer, ULONG sector_count)
+{
+
+UINT                                status;
+ULONG                               block;
+ULONG                               new_block;
+ULONG                               page;
+ULONG                               sector_offset;
+ULONG                               pages_per_block;
+ULONG                               pages_per_write;
+ULONG                               pages;
+ULONG                               i;
+ULONG                               j;
+USHORT                              block_status = 0;
+USHORT                              new_block_status = LX_NAND_BLOCK_STATUS_ALLOCATED;
+UCHAR                               *spare_buffer_ptr;
+UINT                                update_mapping = LX_FALSE;
+UINT                                copy_block = LX_FALSE;
+
+
+    /* Pickup the pages per block and the offset of the first sector in the logical group.  */
+    pages_per_block =  nand_flash -> lx_nand_flash_pages_per_block;
+    sector_offset =  logical_sector % pages_per_block;
+
+    /* See if we can find the logical sector in the current mapping.  */
+    status = _lx_nand_flash_block_find(nand_flash, logical_sector, &block, &block_status);
+
+    /* Check return status.   */
+    if(status != LX_SUCCESS)
+    {
+
+        /* Call system error handler.  */
+        _lx_nand_flash_system_error(nand_flash, status, block, 0);
+
+        /* Determine if the error is fatal.  */
+        if (status != LX_NAND_ERROR_CORRECTED)
+        {
+
+            /* Return an error.  */
+            return(LX_ERROR);
+        }
+    }
+
+    /* Determine if the run fits in the mapped block. The run is written into a new block if
+       the block is full or if it would become full before the run is complete.  */
+    if ((block != LX_NAND_BLOCK_UNMAPPED) && ((block_status & LX_NAND_BLOCK_STATUS_FULL) ||
+        ((block_status & LX_NAND_BLOCK_STATUS_PAGE_NUMBER_MASK) + sector_count > pages_per_block)))
+    {
+
+        /* Set copy block flag.  */
+        copy_block = LX_TRUE;
+    }
+
+#ifdef LX_NAND_FLASH_ENABLE_LAZY_SECTOR_RELEASE
+    /* If the block is about to be copied and has a pending compaction source, compact it now
+       before writing so the new data merges correctly with a single source block.  */
+    if (copy_block &&
+        (nand_flash -> lx_nand_flash_block_compaction_table[logical_sector / pages_per_block] != (USHORT)LX_NAND_BLOCK_UNMAPPED))
+    {
+
+        status = _lx_nand_flash_logical_group_compact(nand_flash, logical_sector / pages_per_block);
+
+        if (status)
+        {
+            _lx_nand_flash_system_error(nand_flash, status, block, 0);
+            return(LX_ERROR);
+        }
+
+        /* Refresh block and block_status after compaction.  */
+        status = _lx_nand_flash_block_find(nand_flash, logical_sector, &block, &block_status);
+
+        if ((status != LX_SUCCESS) && (status != LX_NAND_ERROR_CORRECTED))
+        {
+            return(LX_ERROR);
+        }
+
+        /* The compacted block may have room for the run now.  */
+        copy_block = ((block_status & LX_NAND_BLOCK_STATUS_FULL) ||
+                      ((block_status & LX_NAND_BLOCK_STATUS_PAGE_NUMBER_MASK) + sector_count > pages_per_block)) ? LX_TRUE : LX_FALSE;
+    }
+#endif /* LX_NAND_FLASH_ENABLE_LAZY_SECTOR_RELEASE */
+
+    /* Check if block is unmapped or the run does not fit in the block.  */
+    if ((block == LX_NAND_BLOCK_UNMAPPED) || copy_block)
+    {
+
+        /* Allocate a new block.  */
+        status = _lx_nand_flash_block_allocate(nand_flash, &new_block);
+
+        /* Check if there is no blocks.  */
+        if (status == LX_NO_BLOCKS)
+        {
+
+            /* Return error.  */
+            return(status);
+        }
+
+        /* Check return status.  */
+        else if (status != LX_SUCCESS)
+        {
+
+            /* Call system error handler.  */
+            _lx_nand_flash_system_error(nand_flash, status, new_block, 0);
+
+            /* Determine if the error is fatal.  */
+            if (status != LX_NAND_ERROR_CORRECTED)
+            {
+
+                /* Return an error.  */
+                return(LX_ERROR);
+            }
+        }
+
+        /* Set update mapping flag.  */
+        update_mapping = LX_TRUE;
+    }
+    else
+    {
+
+        /* Set new block to the same as old block.  */
+        new_block = block;
+        new_block_status = block_status;
+    }
+
+    /* Check if copy block flag is set.  */
+    if (copy_block)
+    {
+
+        /* Remove the old block from mapped block list.  */
+        _lx_nand_flash_mapped_block_list_remove(nand_flash, logical_sector / pages_per_block);
+
+        /* Copy valid sectors in front of the run to new block.  */
+        status =  _lx_nand_flash_data_page_copy(nand_flash, logical_sector - sector_offset, block, block_status, new_block, &new_block_status, sector_offset);
+
+        /* Check for an error from flash driver.   */
+        if (status)
+        {
+
+            /* Call system error handler.  */
+            _lx_nand_flash_system_error(nand_flash, status, block, 0);
+
+            /* Return an error.  */
+            return(LX_ERROR);
+        }
+    }
+
+    /* Check if update mapping flag is set.  */
+    if (update_mapping)
+    {
+
+        /* Update block mapping.  */
+        _lx_nand_flash_block_mapping_set(nand_flash, logical_sector, new_block);
+    }
+
+    /* Setup spare buffer pointer.  */
+    spare_buffer_ptr = nand_flash -> lx_nand_flash_page_buffer;
+
+    /* Calculate how many spare areas fit in the page buffer, this limits the pages per driver call.  */
+    pages_per_write = nand_flash -> lx_nand_flash_page_buffer_size / nand_flash -> lx_nand_flash_spare_total_length;
+
+    /* Get page to write.  */
+    page = new_block_status & LX_NAND_BLOCK_STATUS_PAGE_NUMBER_MASK;
+
+    /* Determine if the sector numbers are sequential. Both the sectors and the pages of the run
+       are consecutive, so checking the first page is enough.  */
+    if (page != sector_offset)
+    {
+
+        /* Set non sequential status flag.  */
+        new_block_status |= LX_NAND_BLOCK_STATUS_NON_SEQUENTIAL;
+    }
+
+    /* Loop to write the run.  */
+    for (i = 0; i < sector_count; i += pages)
+    {
+
+        /* Calculate the pages for this driver call.  */
+        pages = sector_count - i;
+        if (pages > pages_per_write)
+        {
+            pages = pages_per_write;
+        }
+
+        /* Set spare buffers to all 0xFF bytes.  */
+        LX_MEMSET(spare_buffer_ptr, 0xFF, pages * nand_flash -> lx_nand_flash_spare_total_length);
+
+        /* Build the spare data for each page.  */
+        for (j = 0; j < pages; j++)
+        {
+
+            /* Check if there is enough spare data for metadata block number.  */
+            if (nand_flash -> lx_nand_flash_spare_data2_length >= sizeof(USHORT))
+            {
+
+                /* Save metadata block number in spare bytes.  */
+                LX_UTILITY_SHORT_SET(&spare_buffer_ptr[j * nand_flash -> lx_nand_flash_spare_total_length + nand_flash -> lx_nand_flash_spare_data2_offset],
+                                     nand_flash -> lx_nand_flash_metadata_block_number);
+            }
+
+            /* Set page type and sector address.  */
+            LX_UTILITY_LONG_SET(&spare_buffer_ptr[j * nand_flash -> lx_nand_flash_spare_total_length + nand_flash -> lx_nand_flash_spare_data1_offset],
+                                LX_NAND_PAGE_TYPE_USER_DATA | (logical_sector + i + j));
+        }
+
+        /* Write the pages.  */
+#ifdef LX_NAND_ENABLE_CONTROL_BLOCK_FOR_DRIVER_INTERFACE
+        status = (nand_flash -> lx_nand_flash_driver_pages_write)(nand_flash, new_block, page, buffer + i * nand_flash -> lx_nand_flash_bytes_per_page, spare_buffer_ptr, pages);
+#else
+        status = (nand_flash -> lx_nand_flash_driver_pages_write)(new_block, page, buffer + i * nand_flash -> lx_nand_flash_bytes_per_page, spare_buffer_ptr, pages);
+#endif
+
+        /* Check for an error from flash driver.   */
+        if (status)
+        {
+
+            /* Call system error handler.  */
+            _lx_nand_flash_system_error(nand_flash, status, new_block, 0);
+
+            /* Return an error.  */
+            return(LX_ERROR);
+        }
+
+        /* Move to the next page.  */
+        page += pages;
+    }
+
+    /* Check if the block is full.  */
+    if (page == pages_per_block)
+    {
+
+        /* Set block full status flag.  */
+        new_block_status |= LX_NAND_BLOCK_STATUS_FULL;
+    }
+
+    /* Build block status word.  */
+    new_block_status = (USHORT)(page | (new_block_status & ~LX_NAND_BLOCK_STATUS_PAGE_NUMBER_MASK));
+
+    /* Determine if there are sectors after the run need to be copied.  */
+    if (copy_block && ((sector_offset + sector_count) < pages_per_block))
+    {
+
+        /* Copy valid sectors behind the run to new block.  */
+        status = _lx_nand_flash_data_page_copy(nand_flash, logical_sector + sector_count, block, block_status, new_block, &new_block_status, pages_per_block - (sector_offset + sector_count));
+
+        /* Check for an error from flash driver.   */
+        if (status)
+        {
+
+            /* Call system error handler.  */
+            _lx_nand_flash_system_error(nand_flash, status, block, 0);
+
+            /* Return an error.  */
+            return(LX_ERROR);
+        }
+    }
+
+    /* Set new block status.  */
+    status = _lx_nand_flash_block_status_set(nand_flash, new_block, new_block_status);
+
+    /* Check for an error from flash driver.   */
+    if (status)
+    {
+
+        /* Call system error handler.  */
+        _lx_nand_flash_system_error(nand_flash, status, new_block, 0);
+
+        /* Return an error.  */
+        return(LX_ERROR);
+    }
+
+    /* Check if copy block flag is set.  */
+    if (copy_block)
+    {
+
+        /* Erase old block.  */
+        status = _lx_nand_flash_driver_block_erase(nand_flash, block, nand_flash -> lx_nand_flash_base_erase_count + nand_flash -> lx_nand_flash_erase_count_table[block] + 1);
+
+        /* Check for an error from flash driver.   */
+        if (status)
+        {
+
+            /* Call system error handler.  */
+            _lx_nand_flash_system_error(nand_flash, status, block, 0);
+
+            /* Return an error.  */
+            return(LX_ERROR);
+        }
+
+        /* Update erase count for the old block.  */
+        status = _lx_nand_flash_erase_count_set(nand_flash, block, (UCHAR)(nand_flash -> lx_nand_flash_erase_count_table[block] + 1));
+
+        /* Check for an error from flash driver.   */
+        if (status)
+        {
+
+            /* Call system error handler.  */
+            _lx_nand_flash_system_error(nand_flash, status, block, 0);
+
+            /* Return an error.  */
+            return(LX_ERROR);
+        }
+
+        /* Check if the block has too many erases.  */
+        if (nand_flash -> lx_nand_flash_erase_count_table[block] > LX_NAND_FLASH_MAX_ERASE_COUNT_DELTA)
+        {
+
+            /* Move data from less worn block.  */
+            _lx_nand_flash_block_data_move(nand_flash, block);
+        }
+        else
+        {
+
+            /* Set the block status to free.  */
+            status = _lx_nand_flash_block_status_set(nand_flash, block, LX_NAND_BLOCK_STATUS_FREE);
+
+            /* Check for an error from flash driver.   */
+            if (status)
+            {
+
+                /* Call system error handler.  */
+                _lx_nand_flash_system_error(nand_flash, status, block, 0);
+
+                /* Return an error.  */
+                return(LX_ERROR);
+            }
+
+            /* Add the block to free block list.  */
+            _lx_nand_flash_free_block_list_add(nand_flash, block);
+        }
+    }
+
+    /* Check if update mapping flag is set.  */
+    if (update_mapping)
+    {
+
+        /* Add the new block to mapped block list.  */
+        _lx_nand_flash_mapped_block_list_add(nand_flash, logical_sector / pages_per_block);
+    }
+
+    /* Return the completion status.  */
+    return(status);
+}
+
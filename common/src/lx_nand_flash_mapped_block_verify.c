@@ -0,0 +1,287 @@
+/***************************************************************************
+ * Copyright (c) 2026-present Eclipse ThreadX contributors
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the MIT License which is available at
+ * https://opensource.org/licenses/MIT.
+ *
+ * SPDX-License-Identifier: MIT
+ **************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */
+/** LevelX Component                                                      */
+/**                                                                       */
+/**   NAND Flash                                                          */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+#define LX_SOURCE_CODE
+
+
+/* Disable ThreadX error checking.  */
+
+#ifndef LX_DISABLE_ERROR_CHECKING
+#define LX_DISABLE_ERROR_CHECKING
+#endif
+
+
+/* Include necessary system files.  */
+
+#include "lx_api.h"
+
+
+
+
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _lx_nand_flash_mapped_block_verify                  PORTABLE C      */
+/*                                                           6.5.1        */
+/*  AUTHOR                                                                */
+/*                                                                        */
+/*    Eclipse ThreadX contributors                                        */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function checks the block status table read at open. Block     */
+/*    status updates are written at the end of each request, so after a   */
+/*    power loss the status of a mapped block may miss the last pages     */
+/*    programmed, and a block unmapped by the request may still be marked */
+/*    allocated.                                                          */
+/*                                                                        */
+/*    The pages following the recorded page count of each mapped block    */
+/*    are scanned up to the first erased page and the status is fixed.    */
+/*    Allocated blocks that are neither mapped nor used for metadata are  */
+/*    erased and marked free.                                             */
+/*                                                                        */
+/*    The check reads one spare area for each mapped block that is not    */
+/*    full, plus one for each page found after the recorded page count,   */
+/*    and erases the reclaimed blocks. It runs only if the flash was not  */
+/*    closed cleanly.                                                     */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    nand_flash                            NAND flash instance           */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    return status                                                       */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    (lx_nand_flash_driver_pages_read)     Read pages                    */
+/*    _lx_nand_flash_block_status_set       Set block status              */
+/*    _lx_nand_flash_driver_block_erase     Erase block                   */
+/*    _lx_nand_flash_erase_count_set        Set erase count               */
+/*    _lx_nand_flash_system_error           Internal system error handler */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    _lx_nand_flash_open_extended                                        */
+/*                                                                        */
+/**************************************************************************/
+UINT  _lx_nand_flash_mapped_block_verify(LX_NAND_FLASH *nand_flash)
+{
+
+UINT        status;
+ULONG       logical_group;
+ULONG       block;
+ULONG       page;
+ULONG       pages_per_block;
+ULONG       spare_word;
+ULONG       i;
+USHORT      block_status;
+USHORT      new_block_status;
+USHORT      *block_in_use;
+UCHAR       *spare_buffer_ptr;
+
+
+    /* Pick up pages per block.  */
+    pages_per_block = nand_flash -> lx_nand_flash_pages_per_block;
+
+    /* Setup spare buffer pointer.  */
+    spare_buffer_ptr = nand_flash -> lx_nand_flash_page_buffer;
+
+    /* The block lists are not built yet, use the block list memory to mark the blocks in use.  */
+    block_in_use = nand_flash -> lx_nand_flash_block_list;
+    LX_MEMSET(block_in_use, 0, nand_flash -> lx_nand_flash_total_blocks * sizeof(*block_in_use));
+
+    /* Loop to mark the metadata blocks.  */
+    for (i = 0; i < nand_flash -> lx_nand_flash_metadata_block_count; i++)
+    {
+
+        /* Mark the metadata block and its backup.  */
+        block_in_use[nand_flash -> lx_nand_flash_metadata_block[i]] = LX_TRUE;
+        block_in_use[nand_flash -> lx_nand_flash_backup_metadata_block[i]] = LX_TRUE;
+    }
+
+    /* Loop to verify the blocks of the logical groups.  */
+    for (logical_group = 0; logical_group < nand_flash -> lx_nand_flash_total_blocks; logical_group++)
+    {
+
+        /* Get the block of the logical group.  */
+        block = nand_flash -> lx_nand_flash_block_mapping_table[logical_group];
+
+        /* Skip unmapped groups.  */
+        if ((block == LX_NAND_BLOCK_UNMAPPED) || (block >= nand_flash -> lx_nand_flash_total_blocks))
+        {
+            continue;
+        }
+
+        /* Mark the block.  */
+        block_in_use[block] = LX_TRUE;
+
+        /* Get the block status.  */
+        block_status = nand_flash -> lx_nand_flash_block_status_table[block];
+
+        /* Skip bad blocks.  */
+        if (block_status == LX_NAND_BLOCK_STATUS_BAD)
+        {
+            continue;
+        }
+
+        /* Check if the status of the block was not written before the power loss.  */
+        if ((block_status == LX_NAND_BLOCK_STATUS_FREE) || ((block_status & LX_NAND_BLOCK_STATUS_ALLOCATED) == 0))
+        {
+
+            /* Count the pages from the start of the block.  */
+            block_status = LX_NAND_BLOCK_STATUS_ALLOCATED;
+        }
+
+        /* Full blocks have no more pages to check.  */
+        if (block_status & LX_NAND_BLOCK_STATUS_FULL)
+        {
+            continue;
+        }
+
+        /* Start at the first page not recorded in the status.  */
+        new_block_status = block_status;
+        page = block_status & LX_NAND_BLOCK_STATUS_PAGE_NUMBER_MASK;
+
+        /* Loop to find the first erased page.  */
+        while (page < pages_per_block)
+        {
+
+            /* Read the spare data of the page.  */
+#ifdef LX_NAND_ENABLE_CONTROL_BLOCK_FOR_DRIVER_INTERFACE
+            status = (nand_flash -> lx_nand_flash_driver_pages_read)(nand_flash, block, page, LX_NULL, spare_buffer_ptr, 1);
+#else
+            status = (nand_flash -> lx_nand_flash_driver_pages_read)(block, page, LX_NULL, spare_buffer_ptr, 1);
+#endif
+
+            /* Check for an error from flash driver.   */
+            if (status)
+            {
+
+                /* Call system error handler.  */
+                _lx_nand_flash_system_error(nand_flash, status, block, page);
+
+                /* Determine if the error is fatal.  */
+                if (status != LX_NAND_ERROR_CORRECTED)
+                {
+
+                    /* Return an error.  */
+                    return(LX_ERROR);
+                }
+            }
+
+            /* Get the page type and sector.  */
+            spare_word = LX_UTILITY_LONG_GET(&spare_buffer_ptr[nand_flash -> lx_nand_flash_spare_data1_offset]);
+
+            /* Check if the page is erased.  */
+            if (spare_word == LX_ALL_ONES)
+            {
+
+                /* The remaining pages are not programmed.  */
+                break;
+            }
+
+            /* Check if the page holds the sector in sequential order.  */
+            if (((spare_word & ~LX_NAND_PAGE_TYPE_USER_DATA_MASK) != LX_NAND_PAGE_TYPE_USER_DATA) ||
+                ((spare_word & LX_NAND_PAGE_TYPE_USER_DATA_MASK) != logical_group * pages_per_block + page))
+            {
+
+                /* Set non sequential status flag.  */
+                new_block_status |= LX_NAND_BLOCK_STATUS_NON_SEQUENTIAL;
+            }
+
+            /* Move to the next page.  */
+            page++;
+        }
+
+        /* Check if the block is full.  */
+        if (page == pages_per_block)
+        {
+
+            /* Set block full status flag.  */
+            new_block_status |= LX_NAND_BLOCK_STATUS_FULL;
+        }
+
+        /* Build block status word.  */
+        new_block_status = (USHORT)(page | (new_block_status & ~LX_NAND_BLOCK_STATUS_PAGE_NUMBER_MASK));
+
+        /* Check if the status needs to be fixed.  */
+        if (new_block_status != nand_flash -> lx_nand_flash_block_status_table[block])
+        {
+
+            /* Set the block status.  */
+            _lx_nand_flash_block_status_set(nand_flash, block, new_block_status);
+        }
+    }
+
+    /* Loop to reclaim allocated blocks that are not in use.  */
+    for (block = 0; block < nand_flash -> lx_nand_flash_total_blocks; block++)
+    {
+
+        /* Get the block status.  */
+        block_status = nand_flash -> lx_nand_flash_block_status_table[block];
+
+        /* Skip blocks in use and blocks that are not allocated.  */
+        if (block_in_use[block] || (block_status == LX_NAND_BLOCK_STATUS_FREE) || (block_status == LX_NAND_BLOCK_STATUS_BAD) ||
+            (block_status == LX_NAND_BLOCK_STATUS_ANCHOR) || ((block_status & LX_NAND_BLOCK_STATUS_ALLOCATED) == 0))
+        {
+            continue;
+        }
+
+#ifdef LX_NAND_FLASH_ENABLE_LAZY_SECTOR_RELEASE
+
+        /* The block may be the source of a deferred compaction, leave it to the compaction recovery.  */
+        if (block_status & LX_NAND_BLOCK_STATUS_COMPACTION_PENDING)
+        {
+            continue;
+        }
+#endif
+
+        /* Erase the block.  */
+        status = _lx_nand_flash_driver_block_erase(nand_flash, block, nand_flash -> lx_nand_flash_base_erase_count + nand_flash -> lx_nand_flash_erase_count_table[block] + 1);
+
+        /* Check for an error from flash driver.   */
+        if (status)
+        {
+
+            /* Call system error handler.  */
+            _lx_nand_flash_system_error(nand_flash, status, block, 0);
+
+            /* Leave the block as it is.  */
+            continue;
+        }
+
+        /* Update erase count for the block.  */
+        _lx_nand_flash_erase_count_set(nand_flash, block, (UCHAR)(nand_flash -> lx_nand_flash_erase_count_table[block] + 1));
+
+        /* Set the block status to free.  */
+        _lx_nand_flash_block_status_set(nand_flash, block, LX_NAND_BLOCK_STATUS_FREE);
+    }
+
+    /* Clear the block list memory.  */
+    LX_MEMSET(block_in_use, 0, nand_flash -> lx_nand_flash_total_blocks * sizeof(*block_in_use));
+
+    /* Return successful completion.  */
+    return(LX_SUCCESS);
+}
+
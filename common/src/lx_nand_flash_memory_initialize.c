@@ -238,6 +238,15 @@ UINT    buffer_size;
         return(LX_NO_MEMORY);
     }
 
+    /* Assign the page buffer space after one page and its spare data to the sector page list.  */
+    nand_flash -> lx_nand_flash_sector_page_list = (USHORT*)(nand_flash -> lx_nand_flash_page_buffer +
+                                                    nand_flash -> lx_nand_flash_bytes_per_page + nand_flash -> lx_nand_flash_spare_total_length);
+
+    /* Update sector page list size.  */
+    nand_flash -> lx_nand_flash_sector_page_list_size = (nand_flash -> lx_nand_flash_page_buffer_size -
+                                                         (nand_flash -> lx_nand_flash_bytes_per_page + nand_flash -> lx_nand_flash_spare_total_length)) /
+                                                         sizeof(*nand_flash -> lx_nand_flash_sector_page_list);
+
     /* Return a successful completion.  */
     return(LX_SUCCESS);
 }
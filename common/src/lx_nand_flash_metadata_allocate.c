@@ -62,11 +62,13 @@
 /*  CALLS                                                                 */
 /*                                                                        */
 /*    _lx_nand_flash_metadata_build         Build metadata                */
+/*    _lx_nand_flash_anchor_write           Write the mount anchor        */
 /*    _lx_nand_flash_driver_block_erase     Erase block                   */
 /*    _lx_nand_flash_block_data_move        Move block data               */
 /*    _lx_nand_flash_free_block_list_add    Add free block list           */
 /*    _lx_nand_flash_block_allocate         Allocate block                */
 /*    _lx_nand_flash_block_status_set       Set block status              */
+/*    _lx_nand_flash_metadata_flush         Flush metadata updates        */
 /*    _lx_nand_flash_metadata_write         Write metadata                */
 /*    _lx_nand_flash_system_error           Internal system error handler */
 /*                                                                        */
@@ -189,6 +191,17 @@ UCHAR   min_erase_count;
             return(status);
         }
 
+        /* Point the anchor at the new metadata before the old metadata blocks are erased.  */
+        status = _lx_nand_flash_anchor_write(nand_flash, LX_NAND_ANCHOR_STATE_MOUNTED);
+
+        /* Check return status.  */
+        if (status != LX_SUCCESS)
+        {
+
+            /* Return error status.  */
+            return(status);
+        }
+
         /* Loop to erase freed blocks.  */
         for (j = 0; j < LX_NAND_FLASH_MAX_METADATA_BLOCKS - 1; j++)
         {
@@ -344,6 +357,17 @@ UCHAR   min_erase_count;
         return (status);
     }
 
+    /* Write the status of the new blocks before the link to them.  */
+    status = _lx_nand_flash_metadata_flush(nand_flash);
+
+    /* Check return status.  */
+    if (status != LX_SUCCESS)
+    {
+
+        /* Return status.  */
+        return (status);
+    }
+
     /* Setup page buffer.  */
     page_buffer_ptr = nand_flash -> lx_nand_flash_page_buffer;
 
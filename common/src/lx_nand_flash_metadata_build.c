@@ -74,6 +74,21 @@ LX_NAND_DEVICE_INFO *nand_device_info_page;
 UINT                page_count;
 UINT                i;
 
+    /* All the table pages are rewritten, clear the dirty page bitmaps.  */
+    LX_MEMSET(nand_flash -> lx_nand_flash_block_status_dirty_pages, 0, sizeof(nand_flash -> lx_nand_flash_block_status_dirty_pages));
+    LX_MEMSET(nand_flash -> lx_nand_flash_erase_count_dirty_pages, 0, sizeof(nand_flash -> lx_nand_flash_erase_count_dirty_pages));
+    LX_MEMSET(nand_flash -> lx_nand_flash_block_mapping_dirty_pages, 0, sizeof(nand_flash -> lx_nand_flash_block_mapping_dirty_pages));
+
+    /* Number the delta records after the snapshot from zero.  */
+    nand_flash -> lx_nand_flash_metadata_delta_sequence = 0;
+
+#ifdef LX_NAND_ENABLE_METADATA_DELTA
+
+    /* Drop the recorded updates, they are part of the rewritten tables.  */
+    nand_flash -> lx_nand_flash_metadata_delta_count = 0;
+    nand_flash -> lx_nand_flash_metadata_delta_overflow = LX_FALSE;
+#endif
+
     /* Build device info page.  */
     nand_device_info_page = (LX_NAND_DEVICE_INFO*)nand_flash -> lx_nand_flash_page_buffer;
     nand_device_info_page -> lx_nand_device_info_signature1 = LX_NAND_DEVICE_INFO_SIGNATURE1;
@@ -0,0 +1,140 @@
+/***************************************************************************
+ * Copyright (c) 2026-present Eclipse ThreadX contributors
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the MIT License which is available at
+ * https://opensource.org/licenses/MIT.
+ *
+ * SPDX-License-Identifier: MIT
+ **************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */
+/** LevelX Component                                                      */
+/**                                                                       */
+/**   NAND Flash                                                          */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+#define LX_SOURCE_CODE
+
+
+/* Disable ThreadX error checking.  */
+
+#ifndef LX_DISABLE_ERROR_CHECKING
+#define LX_DISABLE_ERROR_CHECKING
+#endif
+
+
+/* Include necessary system files.  */
+
+#include "lx_api.h"
+
+
+
+
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _lx_nand_flash_metadata_delta_add                   PORTABLE C      */
+/*                                                           6.5.1        */
+/*  AUTHOR                                                                */
+/*                                                                        */
+/*    Eclipse ThreadX contributors                                        */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function records an update of a metadata table entry for the   */
+/*    next metadata flush. A later update of the same entry replaces the  */
+/*    value of the earlier record. When the records are used up, the      */
+/*    flush falls back to writing the dirty table pages.                  */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    nand_flash                            NAND flash instance           */
+/*    table                                 Table of the entry            */
+/*    index                                 Index of the entry            */
+/*    value                                 New value of the entry        */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    return status                                                       */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    None                                                                */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    Internal LevelX                                                     */
+/*                                                                        */
+/**************************************************************************/
+UINT  _lx_nand_flash_metadata_delta_add(LX_NAND_FLASH *nand_flash, UINT table, ULONG index, ULONG value)
+{
+#ifdef LX_NAND_ENABLE_METADATA_DELTA
+
+ULONG                           i;
+LX_NAND_FLASH_METADATA_DELTA    *delta;
+
+
+    /* Check if the records are used up already.  */
+    if (nand_flash -> lx_nand_flash_metadata_delta_overflow)
+    {
+
+        /* Nothing to record, the table pages are written.  */
+        return(LX_SUCCESS);
+    }
+
+    /* Loop to find an earlier record of the entry.  */
+    for (i = 0; i < nand_flash -> lx_nand_flash_metadata_delta_count; i++)
+    {
+
+        /* Pickup the record.  */
+        delta = &nand_flash -> lx_nand_flash_metadata_delta[i];
+
+        /* Determine if the record is for the same entry.  */
+        if ((delta -> lx_nand_flash_metadata_delta_table == (UCHAR)table) &&
+            (delta -> lx_nand_flash_metadata_delta_index == (USHORT)index))
+        {
+
+            /* Yes, the records are written in one page, just replace the value.  */
+            delta -> lx_nand_flash_metadata_delta_value = (USHORT)value;
+
+            /* Return successful completion.  */
+            return(LX_SUCCESS);
+        }
+    }
+
+    /* Check if there is a free record.  */
+    if (nand_flash -> lx_nand_flash_metadata_delta_count >= LX_NAND_METADATA_DELTA_RECORDS)
+    {
+
+        /* No, write the dirty table pages at the next flush.  */
+        nand_flash -> lx_nand_flash_metadata_delta_overflow = LX_TRUE;
+
+        /* Return successful completion.  */
+        return(LX_SUCCESS);
+    }
+
+    /* Add the record.  */
+    delta = &nand_flash -> lx_nand_flash_metadata_delta[nand_flash -> lx_nand_flash_metadata_delta_count];
+    delta -> lx_nand_flash_metadata_delta_table = (UCHAR)table;
+    delta -> lx_nand_flash_metadata_delta_index = (USHORT)index;
+    delta -> lx_nand_flash_metadata_delta_value = (USHORT)value;
+    nand_flash -> lx_nand_flash_metadata_delta_count++;
+#else
+
+    LX_PARAMETER_NOT_USED(nand_flash);
+    LX_PARAMETER_NOT_USED(table);
+    LX_PARAMETER_NOT_USED(index);
+    LX_PARAMETER_NOT_USED(value);
+#endif
+
+    /* Return successful completion.  */
+    return(LX_SUCCESS);
+}
+
@@ -0,0 +1,172 @@
+/***************************************************************************
+ * Copyright (c) 2026-present Eclipse ThreadX contributors
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the MIT License which is available at
+ * https://opensource.org/licenses/MIT.
+ *
+ * SPDX-License-Identifier: MIT
+ **************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */
+/** LevelX Component                                                      */
+/**                                                                       */
+/**   NAND Flash                                                          */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+#define LX_SOURCE_CODE
+
+
+/* Disable ThreadX error checking.  */
+
+#ifndef LX_DISABLE_ERROR_CHECKING
+#define LX_DISABLE_ERROR_CHECKING
+#endif
+
+
+/* Include necessary system files.  */
+
+#include "lx_api.h"
+
+
+
+
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _lx_nand_flash_metadata_delta_apply                 PORTABLE C      */
+/*                                                           6.5.1        */
+/*  AUTHOR                                                                */
+/*                                                                        */
+/*    Eclipse ThreadX contributors                                        */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function applies the records of a metadata delta page to the   */
+/*    erase count, block mapping and block status tables, in the order    */
+/*    they were recorded. The records are numbered from zero after each   */
+/*    table snapshot, a page that doesn't continue the numbering of the   */
+/*    previous delta page is rejected.                                    */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    nand_flash                            NAND flash instance           */
+/*    page_buffer                           Delta page data               */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    return status                                                       */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    None                                                                */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    _lx_nand_flash_open_extended                                        */
+/*                                                                        */
+/**************************************************************************/
+UINT  _lx_nand_flash_metadata_delta_apply(LX_NAND_FLASH *nand_flash, UCHAR *page_buffer)
+{
+
+ULONG   record;
+ULONG   records;
+UCHAR   *record_ptr;
+UCHAR   table;
+ULONG   index;
+USHORT  value;
+USHORT  sequence;
+USHORT  next_sequence;
+
+
+    /* Get the number of the first record.  */
+    next_sequence = nand_flash -> lx_nand_flash_metadata_delta_sequence;
+
+    /* Get the number of records in a page.  */
+    records = nand_flash -> lx_nand_flash_bytes_per_page / LX_NAND_METADATA_DELTA_RECORD_SIZE;
+
+    /* Loop to apply the records.  */
+    for (record = 0; record < records; record++)
+    {
+
+        /* Pickup the record.  */
+        record_ptr = page_buffer + record * LX_NAND_METADATA_DELTA_RECORD_SIZE;
+        table = record_ptr[LX_NAND_METADATA_DELTA_TABLE_OFFSET];
+        index = LX_UTILITY_SHORT_GET(&record_ptr[LX_NAND_METADATA_DELTA_INDEX_OFFSET]);
+        value = (USHORT)LX_UTILITY_SHORT_GET(&record_ptr[LX_NAND_METADATA_DELTA_VALUE_OFFSET]);
+        sequence = (USHORT)LX_UTILITY_SHORT_GET(&record_ptr[LX_NAND_METADATA_DELTA_SEQUENCE_OFFSET]);
+
+        /* Check for the end of the records.  */
+        if (table == LX_NAND_METADATA_DELTA_END)
+        {
+            break;
+        }
+
+        /* The records continue the numbering of the previous records.  */
+        if (sequence != next_sequence)
+        {
+
+            /* Invalid record, return an error.  */
+            return(LX_ERROR);
+        }
+        next_sequence = (USHORT)(sequence + 1);
+
+        /* Apply the record to its table.  */
+        switch (table)
+        {
+        case LX_NAND_METADATA_DELTA_ERASE_COUNT:
+
+            /* Check if index is valid.  */
+            if (index >= nand_flash -> lx_nand_flash_erase_count_table_size / sizeof(*nand_flash -> lx_nand_flash_erase_count_table))
+            {
+                return(LX_ERROR);
+            }
+
+            /* Update the erase count.  */
+            nand_flash -> lx_nand_flash_erase_count_table[index] = (UCHAR)value;
+            break;
+
+        case LX_NAND_METADATA_DELTA_BLOCK_MAPPING:
+
+            /* Check if index is valid.  */
+            if (index >= nand_flash -> lx_nand_flash_block_mapping_table_size / sizeof(*nand_flash -> lx_nand_flash_block_mapping_table))
+            {
+                return(LX_ERROR);
+            }
+
+            /* Update the block mapping.  */
+            nand_flash -> lx_nand_flash_block_mapping_table[index] = value;
+            break;
+
+        case LX_NAND_METADATA_DELTA_BLOCK_STATUS:
+
+            /* Check if index is valid.  */
+            if (index >= nand_flash -> lx_nand_flash_block_status_table_size / sizeof(*nand_flash -> lx_nand_flash_block_status_table))
+            {
+                return(LX_ERROR);
+            }
+
+            /* Update the block status.  */
+            nand_flash -> lx_nand_flash_block_status_table[index] = value;
+            break;
+
+        default:
+
+            /* Unknown table, return an error.  */
+            return(LX_ERROR);
+        }
+    }
+
+    /* Continue the record numbering after the last record applied.  */
+    nand_flash -> lx_nand_flash_metadata_delta_sequence = next_sequence;
+
+    /* Return successful completion.  */
+    return(LX_SUCCESS);
+}
+
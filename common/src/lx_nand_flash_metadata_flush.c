@@ -0,0 +1,276 @@
+/***************************************************************************
+ * Copyright (c) 2026-present Eclipse ThreadX contributors
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the MIT License which is available at
+ * https://opensource.org/licenses/MIT.
+ *
+ * SPDX-License-Identifier: MIT
+ **************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */
+/** LevelX Component                                                      */
+/**                                                                       */
+/**   NAND Flash                                                          */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+#define LX_SOURCE_CODE
+
+
+/* Disable ThreadX error checking.  */
+
+#ifndef LX_DISABLE_ERROR_CHECKING
+#define LX_DISABLE_ERROR_CHECKING
+#endif
+
+
+/* Include necessary system files.  */
+
+#include "lx_api.h"
+
+
+
+
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _lx_nand_flash_metadata_flush                       PORTABLE C      */
+/*                                                           6.5.1        */
+/*  AUTHOR                                                                */
+/*                                                                        */
+/*    Eclipse ThreadX contributors                                        */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function writes the pending updates of the block status,       */
+/*    erase count and block mapping tables to the metadata block. If the  */
+/*    updates fit in one page, they are written as a delta page of records*/
+/*    that open applies on top of the table pages. Otherwise each dirty   */
+/*    table page is written once, block mapping pages last. The records   */
+/*    and dirty bits are only cleared once their pages are written.       */
+/*                                                                        */
+/*    The updates of a block mapping are flushed with it, so a mapping on */
+/*    flash never refers to a block whose status is older than the        */
+/*    mapping.                                                            */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    nand_flash                            NAND flash instance           */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    return status                                                       */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    _lx_nand_flash_metadata_write         Write metadata                */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    Internal LevelX                                                     */
+/*                                                                        */
+/**************************************************************************/
+UINT  _lx_nand_flash_metadata_flush(LX_NAND_FLASH *nand_flash)
+{
+
+UINT                            status;
+ULONG                           page_number;
+ULONG                           pages;
+ULONG                           bit;
+#ifdef LX_NAND_ENABLE_METADATA_DELTA
+ULONG                           i;
+UCHAR                           *record_ptr;
+LX_NAND_FLASH_METADATA_DELTA    *delta;
+ULONG                           count;
+USHORT                          sequence;
+#endif
+
+
+#ifdef LX_NAND_ENABLE_METADATA_DELTA
+
+    /* Determine if the recorded updates fit in one delta page.  */
+    if ((nand_flash -> lx_nand_flash_metadata_delta_overflow == LX_FALSE) &&
+        (nand_flash -> lx_nand_flash_metadata_delta_count * LX_NAND_METADATA_DELTA_RECORD_SIZE <= nand_flash -> lx_nand_flash_bytes_per_page))
+    {
+
+        /* Check if there is anything to write.  */
+        if (nand_flash -> lx_nand_flash_metadata_delta_count == 0)
+        {
+
+            /* Return successful completion.  */
+            return(LX_SUCCESS);
+        }
+
+        /* Build the delta page in the page buffer, unused records are all ones.  */
+        LX_MEMSET(nand_flash -> lx_nand_flash_page_buffer, 0xFF, nand_flash -> lx_nand_flash_bytes_per_page);
+
+        /* Pickup the number of records and the number of the first record.  */
+        count = nand_flash -> lx_nand_flash_metadata_delta_count;
+        sequence = nand_flash -> lx_nand_flash_metadata_delta_sequence;
+
+        /* Loop to build the records.  */
+        for (i = 0; i < count; i++)
+        {
+
+            /* Pickup the update and its record.  */
+            delta = &nand_flash -> lx_nand_flash_metadata_delta[i];
+            record_ptr = nand_flash -> lx_nand_flash_page_buffer + i * LX_NAND_METADATA_DELTA_RECORD_SIZE;
+
+            /* Build the record.  */
+            record_ptr[LX_NAND_METADATA_DELTA_TABLE_OFFSET] = delta -> lx_nand_flash_metadata_delta_table;
+            LX_UTILITY_SHORT_SET(&record_ptr[LX_NAND_METADATA_DELTA_INDEX_OFFSET], delta -> lx_nand_flash_metadata_delta_index);
+            LX_UTILITY_SHORT_SET(&record_ptr[LX_NAND_METADATA_DELTA_VALUE_OFFSET], delta -> lx_nand_flash_metadata_delta_value);
+            LX_UTILITY_SHORT_SET(&record_ptr[LX_NAND_METADATA_DELTA_SEQUENCE_OFFSET], (USHORT)(sequence + i));
+        }
+
+        /* Take the records out before the page is written, a new metadata block written after
+           the page records and flushes updates of its own.  */
+        nand_flash -> lx_nand_flash_metadata_delta_count = 0;
+        nand_flash -> lx_nand_flash_metadata_delta_sequence = (USHORT)(sequence + count);
+
+        /* Write the delta page.  */
+        status = _lx_nand_flash_metadata_write(nand_flash, nand_flash -> lx_nand_flash_page_buffer, LX_NAND_PAGE_TYPE_METADATA_DELTA);
+
+        /* Check return status.  */
+        if (status != LX_SUCCESS)
+        {
+
+            /* The page is not written, put the records back for the next flush.  */
+            nand_flash -> lx_nand_flash_metadata_delta_count = count;
+            nand_flash -> lx_nand_flash_metadata_delta_sequence = sequence;
+
+            /* Return status.  */
+            return(status);
+        }
+
+        /* Check if all the updates are written.  */
+        if ((nand_flash -> lx_nand_flash_metadata_delta_count == 0) && (nand_flash -> lx_nand_flash_metadata_delta_overflow == LX_FALSE))
+        {
+
+            /* Yes, clear the dirty page bitmaps.  */
+            LX_MEMSET(nand_flash -> lx_nand_flash_block_status_dirty_pages, 0, sizeof(nand_flash -> lx_nand_flash_block_status_dirty_pages));
+            LX_MEMSET(nand_flash -> lx_nand_flash_erase_count_dirty_pages, 0, sizeof(nand_flash -> lx_nand_flash_erase_count_dirty_pages));
+            LX_MEMSET(nand_flash -> lx_nand_flash_block_mapping_dirty_pages, 0, sizeof(nand_flash -> lx_nand_flash_block_mapping_dirty_pages));
+        }
+
+        /* Return successful completion.  */
+        return(LX_SUCCESS);
+    }
+
+    /* Too many updates, the dirty table pages are written instead. Updates made while the pages
+       are written only mark their pages dirty.  */
+    nand_flash -> lx_nand_flash_metadata_delta_count = 0;
+    nand_flash -> lx_nand_flash_metadata_delta_overflow = LX_TRUE;
+#endif
+
+    /* Get the number of pages of the block status table.  */
+    pages = (nand_flash -> lx_nand_flash_block_status_table_size + (nand_flash -> lx_nand_flash_bytes_per_page - 1)) / nand_flash -> lx_nand_flash_bytes_per_page;
+
+    /* Loop to write the dirty block status pages.  */
+    for (page_number = 0; page_number < pages; page_number++)
+    {
+
+        /* Get the bit of the page.  */
+        bit = (ULONG)1 << (page_number % 32);
+
+        /* Check if the page is dirty.  */
+        if (nand_flash -> lx_nand_flash_block_status_dirty_pages[page_number / 32] & bit)
+        {
+
+            /* Save the status table page.  */
+            status = _lx_nand_flash_metadata_write(nand_flash, ((UCHAR*)nand_flash -> lx_nand_flash_block_status_table) +
+                                                    page_number * nand_flash -> lx_nand_flash_bytes_per_page,
+                                                    LX_NAND_PAGE_TYPE_BLOCK_STATUS_TABLE | page_number);
+
+            /* Check return status.  */
+            if (status != LX_SUCCESS)
+            {
+
+                /* Return status.  */
+                return(status);
+            }
+
+            /* The page is written, clear its dirty bit.  */
+            nand_flash -> lx_nand_flash_block_status_dirty_pages[page_number / 32] &= ~bit;
+        }
+    }
+
+    /* Get the number of pages of the erase count table.  */
+    pages = (nand_flash -> lx_nand_flash_erase_count_table_size + (nand_flash -> lx_nand_flash_bytes_per_page - 1)) / nand_flash -> lx_nand_flash_bytes_per_page;
+
+    /* Loop to write the dirty erase count pages.  */
+    for (page_number = 0; page_number < pages; page_number++)
+    {
+
+        /* Get the bit of the page.  */
+        bit = (ULONG)1 << (page_number % 32);
+
+        /* Check if the page is dirty.  */
+        if (nand_flash -> lx_nand_flash_erase_count_dirty_pages[page_number / 32] & bit)
+        {
+
+            /* Save the erase count table page.  */
+            status = _lx_nand_flash_metadata_write(nand_flash, ((UCHAR*)nand_flash -> lx_nand_flash_erase_count_table) +
+                                                    page_number * nand_flash -> lx_nand_flash_bytes_per_page,
+                                                    LX_NAND_PAGE_TYPE_ERASE_COUNT_TABLE | page_number);
+
+            /* Check return status.  */
+            if (status != LX_SUCCESS)
+            {
+
+                /* Return status.  */
+                return(status);
+            }
+
+            /* The page is written, clear its dirty bit.  */
+            nand_flash -> lx_nand_flash_erase_count_dirty_pages[page_number / 32] &= ~bit;
+        }
+    }
+
+    /* Get the number of pages of the block mapping table.  */
+    pages = (nand_flash -> lx_nand_flash_block_mapping_table_size + (nand_flash -> lx_nand_flash_bytes_per_page - 1)) / nand_flash -> lx_nand_flash_bytes_per_page;
+
+    /* Loop to write the dirty block mapping pages.  */
+    for (page_number = 0; page_number < pages; page_number++)
+    {
+
+        /* Get the bit of the page.  */
+        bit = (ULONG)1 << (page_number % 32);
+
+        /* Check if the page is dirty.  */
+        if (nand_flash -> lx_nand_flash_block_mapping_dirty_pages[page_number / 32] & bit)
+        {
+
+            /* Save the mapping table page.  */
+            status = _lx_nand_flash_metadata_write(nand_flash, ((UCHAR*)nand_flash -> lx_nand_flash_block_mapping_table) +
+                                                    page_number * nand_flash -> lx_nand_flash_bytes_per_page,
+                                                    LX_NAND_PAGE_TYPE_BLOCK_MAPPING_TABLE | page_number);
+
+            /* Check return status.  */
+            if (status != LX_SUCCESS)
+            {
+
+                /* Return status.  */
+                return(status);
+            }
+
+            /* The page is written, clear its dirty bit.  */
+            nand_flash -> lx_nand_flash_block_mapping_dirty_pages[page_number / 32] &= ~bit;
+        }
+    }
+#ifdef LX_NAND_ENABLE_METADATA_DELTA
+
+    /* The table pages are written, record the updates again.  */
+    nand_flash -> lx_nand_flash_metadata_delta_overflow = LX_FALSE;
+#endif
+
+    /* Return successful completion.  */
+    return(LX_SUCCESS);
+}
+
@@ -72,9 +72,14 @@
 /*    _lx_nand_flash_memory_initialize      Initialize buffer             */
 /*    _lx_nand_flash_driver_block_status_get                              */
 /*                                          Get block status              */
+/*    _lx_nand_flash_anchor_find            Find the mount anchor         */
+/*    _lx_nand_flash_anchor_write           Write the mount anchor        */
 /*    lx_nand_flash_driver_pages_read       Read pages                    */
+/*    _lx_nand_flash_metadata_delta_apply   Apply metadata delta page     */
+/*    _lx_nand_flash_mapped_block_verify    Verify mapped block status    */
 /*    _lx_nand_flash_free_block_list_add    Add free block to list        */
 /*    _lx_nand_flash_mapped_block_list_add  Add mapped block to list      */
+/*    _lx_nand_flash_metadata_flush         Flush metadata updates        */
 /*    _lx_nand_flash_system_error           System error handler          */
 /*    tx_mutex_create                       Create thread-safe mutex      */
 /*                                                                        */
@@ -99,6 +104,18 @@ UCHAR                       *spare_buffer_ptr;
 UCHAR                       *page_buffer_ptr;
 ULONG                       page_type;
 UCHAR                       page_index;
+UINT                        clean_shutdown;
+#ifndef LX_NAND_DISABLE_FAST_MOUNT
+UINT                        i;
+#endif
+#ifdef LX_NAND_FLASH_ENABLE_LAZY_SECTOR_RELEASE
+ULONG                       blk;
+ULONG                       lg;
+USHORT                      blk_status;
+ULONG                       spare_word;
+ULONG                       found_lg;
+UCHAR                       *spare_ptr;
+#endif
 LX_INTERRUPT_SAVE_AREA
 
     LX_PARAMETER_NOT_USED(name);
@@ -158,86 +175,91 @@ LX_INTERRUPT_SAVE_AREA
     page_buffer_ptr = nand_flash -> lx_nand_flash_page_buffer;
     spare_buffer_ptr = page_buffer_ptr + nand_flash -> lx_nand_flash_bytes_per_page;
 
-    /* Loop through the blocks to check for bad blocks and determine the minimum and maximum erase count for each good block.  */
-    for (block = 0; block < nand_flash -> lx_nand_flash_total_blocks; block++)
-    {
+    /* Find the metadata through the mount anchor.  */
+    status = _lx_nand_flash_anchor_find(nand_flash);
 
-        /* First, check to make sure this block is good.  */
-        status =  _lx_nand_flash_driver_block_status_get(nand_flash, block, &block_status);
+    /* Check if the anchor is not available.  */
+    if (status != LX_SUCCESS)
+    {
 
-        /* Check for an error from flash driver.   */
-        if (status)
+        /* Loop through the blocks to check for bad blocks and determine the minimum and maximum erase count for each good block.  */
+        for (block = 0; block < nand_flash -> lx_nand_flash_total_blocks; block++)
         {
 
-            /* Call system error handler.  */
-            _lx_nand_flash_system_error(nand_flash, status, block, 0);
+            /* First, check to make sure this block is good.  */
+            status =  _lx_nand_flash_driver_block_status_get(nand_flash, block, &block_status);
 
-            /* Return an error.  */
-            return(LX_ERROR);
-        }
+            /* Check for an error from flash driver.   */
+            if (status)
+            {
 
-        /* Is this block bad?  */
-        if (block_status != LX_NAND_GOOD_BLOCK)
-        {
+                /* Call system error handler.  */
+                _lx_nand_flash_system_error(nand_flash, status, block, 0);
 
-            /* Yes, this block is bad.  */
+                /* Return an error.  */
+                return(LX_ERROR);
+            }
 
-            /* Increment the number of bad blocks.  */
-            nand_flash -> lx_nand_flash_bad_blocks++;
+            /* Is this block bad?  */
+            if (block_status != LX_NAND_GOOD_BLOCK)
+            {
 
-            /* Save the block status.  */
-            nand_flash -> lx_nand_flash_block_status_table[block] = LX_NAND_BLOCK_STATUS_BAD;
+                /* Yes, this block is bad.  */
 
-            /* Continue to the next block.  */
-            continue;
-        }
+                /* Save the block status.  */
+                nand_flash -> lx_nand_flash_block_status_table[block] = LX_NAND_BLOCK_STATUS_BAD;
 
-        /* Call driver read function to read page 0.  */
+                /* Continue to the next block.  */
+                continue;
+            }
+
+            /* Call driver read function to read page 0.  */
 #ifdef LX_NAND_ENABLE_CONTROL_BLOCK_FOR_DRIVER_INTERFACE
-        status = (nand_flash -> lx_nand_flash_driver_pages_read)(nand_flash, block, 0, page_buffer_ptr, spare_buffer_ptr, 1);
+            status = (nand_flash -> lx_nand_flash_driver_pages_read)(nand_flash, block, 0, page_buffer_ptr, spare_buffer_ptr, 1);
 #else
-        status = (nand_flash -> lx_nand_flash_driver_pages_read)(block, 0, page_buffer_ptr, spare_buffer_ptr, 1);
+            status = (nand_flash -> lx_nand_flash_driver_pages_read)(block, 0, page_buffer_ptr, spare_buffer_ptr, 1);
 #endif
 
-        /* Check for an error from flash driver.   */
-        if (status)
-        {
+            /* Check for an error from flash driver.   */
+            if (status)
+            {
 
-            /* Call system error handler.  */
-            _lx_nand_flash_system_error(nand_flash, status, block, 0);
+                /* Call system error handler.  */
+                _lx_nand_flash_system_error(nand_flash, status, block, 0);
 
-            /* Determine if the error is fatal.  */
-            if (status != LX_NAND_ERROR_CORRECTED)
-            {
+                /* Determine if the error is fatal.  */
+                if (status != LX_NAND_ERROR_CORRECTED)
+                {
 
-                /* Return an error.  */
-                return(LX_ERROR);
+                    /* Return an error.  */
+                    return(LX_ERROR);
+                }
             }
-        }
 
-        /* Get the page type.  */
-        page_type = LX_UTILITY_LONG_GET(&spare_buffer_ptr[nand_flash -> lx_nand_flash_spare_data1_offset]);
+            /* Get the page type.  */
+            page_type = LX_UTILITY_LONG_GET(&spare_buffer_ptr[nand_flash -> lx_nand_flash_spare_data1_offset]);
 
-        /* Check if the type is device info.  */
-        if (page_type == LX_NAND_PAGE_TYPE_DEVICE_INFO)
-        {
+            /* Check if the type is device info.  */
+            if (page_type == LX_NAND_PAGE_TYPE_DEVICE_INFO)
+            {
 
-            /* Get the device info page.  */
-            nand_device_info_page = (LX_NAND_DEVICE_INFO*)page_buffer_ptr;
+                /* Get the device info page.  */
+                nand_device_info_page = (LX_NAND_DEVICE_INFO*)page_buffer_ptr;
 
-            /* Check signature.  */
-            if (nand_device_info_page -> lx_nand_device_info_signature1 == LX_NAND_DEVICE_INFO_SIGNATURE1 &&
-                nand_device_info_page -> lx_nand_device_info_signature2 == LX_NAND_DEVICE_INFO_SIGNATURE2)
-            {
+                /* Check signature.  */
+                if (nand_device_info_page -> lx_nand_device_info_signature1 == LX_NAND_DEVICE_INFO_SIGNATURE1 &&
+                    nand_device_info_page -> lx_nand_device_info_signature2 == LX_NAND_DEVICE_INFO_SIGNATURE2)
+                {
+
+                    /* Save the block numbers.  */
+                    nand_flash -> lx_nand_flash_metadata_block_number = nand_device_info_page -> lx_nand_device_info_metadata_block_number;
+                    nand_flash -> lx_nand_flash_backup_metadata_block_number = nand_device_info_page -> lx_nand_device_info_backup_metadata_block_number;
+                    break;
+                }
 
-                /* Save the block numbers.  */
-                nand_flash -> lx_nand_flash_metadata_block_number = nand_device_info_page -> lx_nand_device_info_metadata_block_number;
-                nand_flash -> lx_nand_flash_backup_metadata_block_number = nand_device_info_page -> lx_nand_device_info_backup_metadata_block_number;
-                break;
             }
 
         }
-
     }
 
     /* Check if we have found the metadata block.  */
@@ -257,6 +279,9 @@ LX_INTERRUPT_SAVE_AREA
     /* Found one metadata block.  */
     nand_flash -> lx_nand_flash_metadata_block_count = 1;
 
+    /* Start with the first metadata block.  */
+    block = nand_flash -> lx_nand_flash_metadata_block_number;
+
     /* Clear searched block count.  */
     block_count = 0;
 
@@ -308,6 +333,9 @@ LX_INTERRUPT_SAVE_AREA
 
                 /* Get the base erase count.  */
                 nand_flash -> lx_nand_flash_base_erase_count = nand_device_info_page -> lx_nand_device_info_base_erase_count;
+
+                /* A snapshot of the tables starts, its delta records are numbered from zero.  */
+                nand_flash -> lx_nand_flash_metadata_delta_sequence = 0;
                 break;
 
             case LX_NAND_PAGE_TYPE_ERASE_COUNT_TABLE:
@@ -358,6 +386,12 @@ LX_INTERRUPT_SAVE_AREA
                     page_buffer_ptr, nand_flash -> lx_nand_flash_bytes_per_page);
                 break;
 
+            case LX_NAND_PAGE_TYPE_METADATA_DELTA:
+
+                /* Apply the table updates on top of the table pages read so far.  */
+                status = _lx_nand_flash_metadata_delta_apply(nand_flash, page_buffer_ptr);
+                break;
+
             case LX_NAND_PAGE_TYPE_FREE_PAGE:
 
                 /* Found a free page. Update current page.  */
@@ -439,44 +473,91 @@ LX_INTERRUPT_SAVE_AREA
         return(LX_ERROR);
     }
 
-    /* Loop to build free and mapped block lists.  */
-    for (block = 0; block < nand_flash -> lx_nand_flash_total_blocks; block++)
+    /* Assume the flash was not closed after the last update.  */
+    clean_shutdown = LX_FALSE;
+#ifndef LX_NAND_DISABLE_FAST_MOUNT
+
+    /* Loop to check the anchor blocks.  */
+    for (i = 0; i < LX_NAND_ANCHOR_BLOCKS; i++)
     {
 
-        /* Check for free blocks.  */
-        if (nand_flash -> lx_nand_flash_block_status_table[block] == LX_NAND_BLOCK_STATUS_FREE)
+        /* Check if the block is not reserved for the anchor.  */
+        if ((nand_flash -> lx_nand_flash_anchor_block[i] != LX_NAND_BLOCK_UNMAPPED) &&
+            (nand_flash -> lx_nand_flash_block_status_table[nand_flash -> lx_nand_flash_anchor_block[i]] != LX_NAND_BLOCK_STATUS_ANCHOR))
         {
 
-            /* Add the block to free block list.  */
-            _lx_nand_flash_free_block_list_add(nand_flash, block);
+            /* Don't use the block for the anchor.  */
+            nand_flash -> lx_nand_flash_anchor_block[i] = LX_NAND_BLOCK_UNMAPPED;
         }
+    }
 
-        /* Check for mapped blocks.  */
-        if (nand_flash -> lx_nand_flash_block_mapping_table[block] != LX_NAND_BLOCK_UNMAPPED)
+    /* Check if the anchor was written by close at the end of the metadata.  */
+    if ((nand_flash -> lx_nand_flash_anchor.lx_nand_anchor_state == LX_NAND_ANCHOR_STATE_CLEAN) &&
+        (nand_flash -> lx_nand_flash_anchor.lx_nand_anchor_metadata_block_current == nand_flash -> lx_nand_flash_metadata_block_number_current) &&
+        (nand_flash -> lx_nand_flash_anchor.lx_nand_anchor_metadata_page_current == nand_flash -> lx_nand_flash_metadata_block_current_page))
+    {
+
+        /* The tables match the flash, no recovery is needed.  */
+        clean_shutdown = LX_TRUE;
+    }
+
+    /* Check if the anchor has to be updated before the flash is changed.  */
+    if ((clean_shutdown == LX_TRUE) ||
+        (nand_flash -> lx_nand_flash_anchor.lx_nand_anchor_metadata_block_number != nand_flash -> lx_nand_flash_metadata_block_number))
+    {
+
+        /* Write the anchor, a power loss from now on is recovered by the next open.  */
+        status = _lx_nand_flash_anchor_write(nand_flash, LX_NAND_ANCHOR_STATE_MOUNTED);
+
+        /* Check return status.  */
+        if (status != LX_SUCCESS)
         {
 
-            /* Add the block to free block list.  */
-            _lx_nand_flash_mapped_block_list_add(nand_flash, block);
+            /* Return an error.  */
+            return(LX_ERROR);
         }
     }
+#endif
+
+    /* Check if the flash was not closed after the last update.  */
+    if (clean_shutdown == LX_FALSE)
+    {
 
+        /* Verify the status of the mapped blocks and reclaim unused allocated blocks.  */
+        status = _lx_nand_flash_mapped_block_verify(nand_flash);
+
+        /* Check return status.  */
+        if (status != LX_SUCCESS)
+        {
+
+            /* Return an error.  */
+            return(LX_ERROR);
+        }
+    }
 
 #ifdef LX_NAND_FLASH_ENABLE_LAZY_SECTOR_RELEASE
-    {
 
-    ULONG   blk;
-    ULONG   lg;
-    USHORT  blk_status;
+    /* The block lists are not built yet, use the block list memory to mark the mapped blocks.  */
+    LX_MEMSET(nand_flash -> lx_nand_flash_block_list, 0, nand_flash -> lx_nand_flash_total_blocks * sizeof(*nand_flash -> lx_nand_flash_block_list));
 
-    /* Phase 1: Rebuild compaction table and recover from mid-release crashes.
+    /* Loop to mark the mapped blocks.  */
+    for (lg = 0; lg < nand_flash -> lx_nand_flash_total_blocks; lg++)
+    {
+        if (nand_flash -> lx_nand_flash_block_mapping_table[lg] < nand_flash -> lx_nand_flash_total_blocks)
+        {
+            nand_flash -> lx_nand_flash_block_list[nand_flash -> lx_nand_flash_block_mapping_table[lg]] = LX_TRUE;
+        }
+    }
+
+    /* Rebuild compaction table and recover from mid-release crashes.
        Scan all blocks for COMPACTION_PENDING.  */
     for (blk = 0; blk < nand_flash -> lx_nand_flash_total_blocks; blk++)
     {
 
         blk_status = nand_flash -> lx_nand_flash_block_status_table[blk];
 
-        /* FREE (0xFFFF) and BAD (0xFF00) both have COMPACTION_PENDING bit set; skip them.  */
-        if ((blk_status == LX_NAND_BLOCK_STATUS_FREE) || (blk_status == LX_NAND_BLOCK_STATUS_BAD))
+        /* FREE (0xFFFF), BAD (0xFF00) and ANCHOR (0x7F00) all have COMPACTION_PENDING bit set; skip them.  */
+        if ((blk_status == LX_NAND_BLOCK_STATUS_FREE) || (blk_status == LX_NAND_BLOCK_STATUS_BAD) || (blk_status == LX_NAND_BLOCK_STATUS_ANCHOR))
         {
             continue;
         }
@@ -486,20 +567,7 @@ LX_INTERRUPT_SAVE_AREA
 
             /* Check if any logical group still maps to this physical block.
                If so, the mapping update didn't happen — abort the lazy release.  */
-            lg = nand_flash -> lx_nand_flash_total_blocks;
-            {
-                ULONG search_lg;
-                for (search_lg = 0; search_lg < nand_flash -> lx_nand_flash_total_blocks; search_lg++)
-                {
-                    if (nand_flash -> lx_nand_flash_block_mapping_table[search_lg] == (USHORT)blk)
-                    {
-                        lg = search_lg;
-                        break;
-                    }
-                }
-            }
-
-            if (lg != nand_flash -> lx_nand_flash_total_blocks)
+            if (nand_flash -> lx_nand_flash_block_list[blk])
             {
 
                 /* Scenario A: crash after COMPACTION_PENDING set, before mapping updated.
@@ -511,11 +579,6 @@ LX_INTERRUPT_SAVE_AREA
             {
 
                 /* Scenario B: deferred compaction — scan block pages to find the LG.  */
-                ULONG   page;
-                ULONG   spare_word;
-                ULONG   found_lg;
-                UCHAR  *spare_ptr;
-
                 spare_ptr  = (UCHAR*)nand_flash -> lx_nand_flash_page_buffer;
                 found_lg   = nand_flash -> lx_nand_flash_total_blocks;
 
@@ -543,8 +606,7 @@ LX_INTERRUPT_SAVE_AREA
                     }
                 }
 
-                if ((found_lg != nand_flash -> lx_nand_flash_total_blocks) &&
-                    (found_lg < nand_flash -> lx_nand_flash_total_blocks))
+                if (found_lg < nand_flash -> lx_nand_flash_total_blocks)
                 {
                     nand_flash -> lx_nand_flash_block_compaction_table[found_lg] = (USHORT)blk;
                 }
@@ -552,68 +614,52 @@ LX_INTERRUPT_SAVE_AREA
         }
     }
 
-    /* Phase 2: Orphan block recovery — erase ALLOCATED blocks not referenced
-       by any mapping entry and not marked COMPACTION_PENDING.  */
-    for (blk = 0; blk < nand_flash -> lx_nand_flash_total_blocks; blk++)
-    {
+    /* Clear the block list memory.  */
+    LX_MEMSET(nand_flash -> lx_nand_flash_block_list, 0, nand_flash -> lx_nand_flash_total_blocks * sizeof(*nand_flash -> lx_nand_flash_block_list));
+#endif
 
-        ULONG   found;
+    /* Clear the bad block count.  */
+    nand_flash -> lx_nand_flash_bad_blocks = 0;
 
-        blk_status = nand_flash -> lx_nand_flash_block_status_table[blk];
+    /* Loop to build free and mapped block lists.  */
+    for (block = 0; block < nand_flash -> lx_nand_flash_total_blocks; block++)
+    {
 
-        if ((blk_status == LX_NAND_BLOCK_STATUS_FREE) || (blk_status == LX_NAND_BLOCK_STATUS_BAD))
+        /* Check for free blocks.  */
+        if (nand_flash -> lx_nand_flash_block_status_table[block] == LX_NAND_BLOCK_STATUS_FREE)
         {
-            continue;
-        }
 
-        if (blk_status & LX_NAND_BLOCK_STATUS_COMPACTION_PENDING)
-        {
-            continue;
+            /* Add the block to free block list.  */
+            _lx_nand_flash_free_block_list_add(nand_flash, block);
         }
 
-        if (!(blk_status & LX_NAND_BLOCK_STATUS_ALLOCATED))
+        /* Check for bad blocks.  */
+        else if (nand_flash -> lx_nand_flash_block_status_table[block] == LX_NAND_BLOCK_STATUS_BAD)
         {
-            continue;
-        }
 
-        /* Search for this block in the mapping table.  */
-        found = LX_FALSE;
-        for (lg = 0; lg < nand_flash -> lx_nand_flash_total_blocks; lg++)
-        {
-            if (nand_flash -> lx_nand_flash_block_mapping_table[lg] == (USHORT)blk)
-            {
-                found = LX_TRUE;
-                break;
-            }
+            /* Increment the number of bad blocks.  */
+            nand_flash -> lx_nand_flash_bad_blocks++;
         }
 
-        if (!found)
+        /* Check for mapped blocks.  */
+        if (nand_flash -> lx_nand_flash_block_mapping_table[block] != LX_NAND_BLOCK_UNMAPPED)
         {
 
-            /* Orphan block: erase and reclaim.  */
-            status = _lx_nand_flash_driver_block_erase(nand_flash, blk,
-                         nand_flash -> lx_nand_flash_base_erase_count +
-                         nand_flash -> lx_nand_flash_erase_count_table[blk] + 1);
-
-            if (status)
-            {
-                _lx_nand_flash_system_error(nand_flash, status, blk, 0);
-                continue;
-            }
-
-            status = _lx_nand_flash_erase_count_set(nand_flash, blk,
-                         (UCHAR)(nand_flash -> lx_nand_flash_erase_count_table[blk] + 1));
-
-            if (!status)
-            {
-                (void)_lx_nand_flash_block_status_set(nand_flash, blk, LX_NAND_BLOCK_STATUS_FREE);
-                _lx_nand_flash_free_block_list_add(nand_flash, blk);
-            }
+            /* Add the block to free block list.  */
+            _lx_nand_flash_mapped_block_list_add(nand_flash, block);
         }
     }
 
+    /* Write the block status and erase count updates made by the open.  */
+    status = _lx_nand_flash_metadata_flush(nand_flash);
+
+    /* Check return status.  */
+    if (status != LX_SUCCESS)
+    {
+
+        /* Return an error.  */
+        return(LX_ERROR);
     }
-#endif /* LX_NAND_FLASH_ENABLE_LAZY_SECTOR_RELEASE */
 
 
 #ifdef LX_THREAD_SAFE_ENABLE
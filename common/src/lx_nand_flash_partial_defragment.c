@@ -35,12 +35,13 @@
 #include "lx_api.h"
 
 
+
 /**************************************************************************/
 /*                                                                        */
 /*  FUNCTION                                               RELEASE        */
 /*                                                                        */
 /*    _lx_nand_flash_partial_defragment                   PORTABLE C      */
-/*                                                           6.2.1       */
+/*                                                           6.5.1        */
 /*  AUTHOR                                                                */
 /*                                                                        */
 /*    William E. Lamie, Microsoft Corporation                             */
@@ -48,7 +49,14 @@
 /*  DESCRIPTION                                                           */
 /*                                                                        */
 /*    This function defragments the NAND flash up to the specified        */
-/*    number of blocks.                                                   */
+/*    number of blocks. Pending compactions are completed first, then     */
+/*    logical groups mapped to non-sequential blocks are rewritten into   */
+/*    new blocks without superseded or released pages. Full blocks go     */
+/*    first since they would otherwise be copied by the next sector       */
+/*    write. Each compaction and each non-sequential block examined       */
+/*    counts as one block, whether it is rewritten or not, and the next   */
+/*    call resumes after the last group examined. The old blocks are      */
+/*    erased before they are returned to the free list.                   */
 /*                                                                        */
 /*  INPUT                                                                 */
 /*                                                                        */
@@ -62,7 +70,13 @@
 /*                                                                        */
 /*  CALLS                                                                 */
 /*                                                                        */
-/*    None                                                                */
+/*    _lx_nand_flash_logical_group_compact  Compact a logical group       */
+/*    _lx_nand_flash_logical_group_consolidate                            */
+/*                                          Consolidate a logical group   */
+/*    _lx_nand_flash_metadata_flush         Flush metadata updates        */
+/*    _lx_nand_flash_system_error           Internal system error handler */
+/*    tx_mutex_get                          Get thread protection         */
+/*    tx_mutex_put                          Release thread protection     */
 /*                                                                        */
 /*  CALLED BY                                                             */
 /*                                                                        */
@@ -73,11 +87,139 @@
 UINT  _lx_nand_flash_partial_defragment(LX_NAND_FLASH *nand_flash, UINT max_blocks)
 {
 
-    LX_PARAMETER_NOT_USED(nand_flash);
-    LX_PARAMETER_NOT_USED(max_blocks);
+UINT        status = LX_SUCCESS;
+UINT        blocks;
+UINT        consolidated;
+UINT        pass;
+USHORT      full_flag;
+ULONG       logical_group;
+ULONG       last_group;
+ULONG       block;
+ULONG       i;
 
-    /* Return not supported.  */
-    return(LX_NOT_SUPPORTED);
-}
 
+#ifdef LX_THREAD_SAFE_ENABLE
+
+    /* Obtain the thread safe mutex.  */
+    tx_mutex_get(&nand_flash -> lx_nand_flash_mutex, TX_WAIT_FOREVER);
+#endif
+
+    /* Determine if the maximum number of blocks exceeds the total blocks in this flash instance.  */
+    if (max_blocks >= nand_flash -> lx_nand_flash_total_blocks)
+    {
+
+        /* Adjust the maximum to the total number of blocks.  */
+        max_blocks =  (UINT)nand_flash -> lx_nand_flash_total_blocks;
+    }
+
+    /* Initialize the number of blocks defragmented.  */
+    blocks = 0;
+
+    /* Resume from the same group if no block is examined.  */
+    last_group = nand_flash -> lx_nand_flash_defragment_logical_group;
+
+#ifdef LX_NAND_FLASH_ENABLE_LAZY_SECTOR_RELEASE
+
+    /* Compact the logical groups that have a deferred compaction pending.  */
+    for (logical_group = 0; (logical_group < nand_flash -> lx_nand_flash_total_blocks) && (blocks < max_blocks); logical_group++)
+    {
+
+        /* Check if a compaction is pending for this group.  */
+        if (nand_flash -> lx_nand_flash_block_compaction_table[logical_group] != (USHORT)LX_NAND_BLOCK_UNMAPPED)
+        {
+
+            /* Compact the logical group.  */
+            status = _lx_nand_flash_logical_group_compact(nand_flash, logical_group);
+
+            /* On error, continue to compact remaining groups.  */
+            if (status)
+            {
+                _lx_nand_flash_system_error(nand_flash, status, logical_group, 0);
+            }
+
+            /* Increment the number of blocks defragmented.  */
+            blocks++;
+        }
+    }
+
+    /* Compaction errors are only reported to the system error handler.  */
+    status = LX_SUCCESS;
+#endif
+
+    /* Loop to consolidate groups in full blocks first, then the others.  */
+    for (pass = 0; (pass < 2) && (blocks < max_blocks); pass++)
+    {
+
+        /* Get the full flag of the blocks to consolidate in this pass.  */
+        full_flag = (pass == 0) ? (USHORT)LX_NAND_BLOCK_STATUS_FULL : (USHORT)0;
+
+        /* Loop through the logical groups, starting after the last group examined.  */
+        for (i = 0; (i < nand_flash -> lx_nand_flash_total_blocks) && (blocks < max_blocks); i++)
+        {
+
+            /* Get the logical group.  */
+            logical_group = (nand_flash -> lx_nand_flash_defragment_logical_group + i) % nand_flash -> lx_nand_flash_total_blocks;
+
+            /* Get the block of the logical group.  */
+            block = nand_flash -> lx_nand_flash_block_mapping_table[logical_group];
+
+            /* Check if the group is mapped to a non-sequential block of the current kind.  */
+            if ((block == LX_NAND_BLOCK_UNMAPPED) ||
+                ((nand_flash -> lx_nand_flash_block_status_table[block] & LX_NAND_BLOCK_STATUS_NON_SEQUENTIAL) == 0) ||
+                ((nand_flash -> lx_nand_flash_block_status_table[block] & LX_NAND_BLOCK_STATUS_FULL) != full_flag))
+            {
+                continue;
+            }
+
+            /* The block is examined, count it whether it is rewritten or not.  */
+            blocks++;
+
+            /* Resume after this group in the next call.  */
+            last_group = logical_group + 1;
+
+            /* Consolidate the logical group.  */
+            status = _lx_nand_flash_logical_group_consolidate(nand_flash, logical_group, &consolidated);
+
+            /* Check if there is no free block left, the remaining groups can't be consolidated now.  */
+            if (status == LX_NO_BLOCKS)
+            {
+
+                /* Stop defragmenting.  */
+                status = LX_SUCCESS;
+                blocks = max_blocks;
+                break;
+            }
+
+            /* Check for an error.  */
+            if (status)
+            {
+
+                /* Stop defragmenting and return an error.  */
+                status = LX_ERROR;
+                blocks = max_blocks;
+                break;
+            }
+        }
+    }
+
+    /* Save the group to resume from.  */
+    nand_flash -> lx_nand_flash_defragment_logical_group = last_group % nand_flash -> lx_nand_flash_total_blocks;
+
+    /* Write the metadata updates of the defragmentation.  */
+    if (_lx_nand_flash_metadata_flush(nand_flash) != LX_SUCCESS)
+    {
+
+        /* Return an error.  */
+        status = LX_ERROR;
+    }
+
+#ifdef LX_THREAD_SAFE_ENABLE
+
+    /* Release the thread safe mutex.  */
+    tx_mutex_put(&nand_flash -> lx_nand_flash_mutex);
+#endif
+
+    /* Return status.  */
+    return(status);
+}
 
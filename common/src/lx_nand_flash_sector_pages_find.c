@@ -0,0 +1,254 @@
+/***************************************************************************
+ * Copyright (c) 2026-present Eclipse ThreadX contributors
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the MIT License which is available at
+ * https://opensource.org/licenses/MIT.
+ *
+ * SPDX-License-Identifier: MIT
+ **************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */
+/** LevelX Component                                                      */
+/**                                                                       */
+/**   NAND Flash                                                          */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+#define LX_SOURCE_CODE
+
+
+/* Disable ThreadX error checking.  */
+
+#ifndef LX_DISABLE_ERROR_CHECKING
+#define LX_DISABLE_ERROR_CHECKING
+#endif
+
+
+/* Include necessary system files.  */
+
+#include "lx_api.h"
+
+
+
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _lx_nand_flash_sector_pages_find                    PORTABLE C      */
+/*                                                           6.5.1        */
+/*  AUTHOR                                                                */
+/*                                                                        */
+/*    Eclipse ThreadX contributors                                        */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function finds the pages of a run of logical sectors in one    */
+/*    block. Only the page list entries that are LX_NAND_SECTOR_PAGE_     */
+/*    NOT_FOUND on entry are resolved, so the same list can be passed for */
+/*    more than one block. A resolved entry holds the page number, with   */
+/*    LX_NAND_SECTOR_PAGE_RELEASED set if the sector has been released.   */
+/*                                                                        */
+/*    Pages of a sequential block are found without accessing the flash.  */
+/*    Pages of a non-sequential block are taken from the extended cache   */
+/*    when it is enabled and the block is mapped to the logical group.    */
+/*    Otherwise the block is scanned once from the last page backward,    */
+/*    reading as many spare areas per driver call as fit in one page and  */
+/*    its spare data of the page buffer, and the scan stops as soon as    */
+/*    all the entries are resolved.                                       */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    nand_flash                            NAND flash instance           */
+/*    block                                 Block number                  */
+/*    block_status                          Block status                  */
+/*    logical_sector                        First logical sector          */
+/*    sector_count                          Number of sectors             */
+/*    page_list                             Page list of the sectors      */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    return status                                                       */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    _lx_nand_flash_extended_cache_page_list_get                         */
+/*                                          Get cached page list          */
+/*    lx_nand_flash_driver_pages_read       Read pages                    */
+/*    _lx_nand_flash_system_error           Internal system error handler */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    Internal LevelX                                                     */
+/*                                                                        */
+/**************************************************************************/
+UINT  _lx_nand_flash_sector_pages_find(LX_NAND_FLASH *nand_flash, ULONG block, USHORT block_status, ULONG logical_sector, ULONG sector_count, USHORT *page_list)
+{
+
+UINT        status;
+ULONG       i;
+ULONG       available_pages;
+ULONG       remaining_sectors;
+ULONG       pages_per_read;
+ULONG       start_page;
+ULONG       pages;
+ULONG       spare_data1;
+ULONG       sector_offset;
+UCHAR       *spare_buffer_ptr;
+#ifndef LX_NAND_DISABLE_EXTENDED_CACHE
+USHORT      *cache_page_list;
+#endif
+
+
+    /* Get available pages in this block.  */
+    available_pages = (block_status & LX_NAND_BLOCK_STATUS_FULL) ? nand_flash -> lx_nand_flash_pages_per_block : (block_status & LX_NAND_BLOCK_STATUS_PAGE_NUMBER_MASK);
+
+    /* Determine if the pages are recorded sequentially.  */
+    if ((block_status & LX_NAND_BLOCK_STATUS_NON_SEQUENTIAL) == 0)
+    {
+
+        /* Get the page of the first sector.  */
+        sector_offset = logical_sector % nand_flash -> lx_nand_flash_pages_per_block;
+
+        /* Loop to set the page of each sector.  */
+        for (i = 0; i < sector_count; i++)
+        {
+
+            /* Check if the sector is available and not resolved yet.  */
+            if ((sector_offset + i < available_pages) && (page_list[i] == LX_NAND_SECTOR_PAGE_NOT_FOUND))
+            {
+
+                /* Set the page number.  */
+                page_list[i] = (USHORT)(sector_offset + i);
+            }
+        }
+
+        /* Return successful completion.  */
+        return(LX_SUCCESS);
+    }
+
+#ifndef LX_NAND_DISABLE_EXTENDED_CACHE
+
+    /* Determine if the extended cache is enabled and the block is mapped to the logical group.  */
+    if ((nand_flash -> lx_nand_flash_extended_cache_entries) &&
+        (block == nand_flash -> lx_nand_flash_block_mapping_table[logical_sector / nand_flash -> lx_nand_flash_pages_per_block]))
+    {
+
+        /* Get the page list of the logical group from the cache.  */
+        status = _lx_nand_flash_extended_cache_page_list_get(nand_flash, logical_sector / nand_flash -> lx_nand_flash_pages_per_block,
+                                                             block, block_status, &cache_page_list);
+
+        /* Check return status.  */
+        if (status)
+        {
+
+            /* Return an error.  */
+            return(LX_ERROR);
+        }
+
+        /* Get the offset of the first sector in the logical group.  */
+        sector_offset = logical_sector % nand_flash -> lx_nand_flash_pages_per_block;
+
+        /* Loop to set the page of each sector not resolved yet.  */
+        for (i = 0; i < sector_count; i++)
+        {
+            if (page_list[i] == LX_NAND_SECTOR_PAGE_NOT_FOUND)
+            {
+
+                /* Set the page number from the cache.  */
+                page_list[i] = cache_page_list[sector_offset + i];
+            }
+        }
+
+        /* Return successful completion.  */
+        return(LX_SUCCESS);
+    }
+#endif
+
+    /* Count the sectors to resolve.  */
+    remaining_sectors = 0;
+    for (i = 0; i < sector_count; i++)
+    {
+        if (page_list[i] == LX_NAND_SECTOR_PAGE_NOT_FOUND)
+        {
+            remaining_sectors++;
+        }
+    }
+
+    /* Setup spare buffer pointer.  */
+    spare_buffer_ptr = nand_flash -> lx_nand_flash_page_buffer;
+
+    /* Calculate the number of spare areas to read in one driver call.  */
+    pages_per_read = (nand_flash -> lx_nand_flash_bytes_per_page + nand_flash -> lx_nand_flash_spare_total_length) / nand_flash -> lx_nand_flash_spare_total_length;
+
+    /* Loop to scan the block from the last page backward.  */
+    while ((available_pages > 0) && (remaining_sectors > 0))
+    {
+
+        /* Calculate the pages to read.  */
+        pages = (available_pages > pages_per_read) ? pages_per_read : available_pages;
+        start_page = available_pages - pages;
+
+        /* Read the spare data of the pages.  */
+#ifdef LX_NAND_ENABLE_CONTROL_BLOCK_FOR_DRIVER_INTERFACE
+        status = (nand_flash -> lx_nand_flash_driver_pages_read)(nand_flash, block, start_page, LX_NULL, spare_buffer_ptr, pages);
+#else
+        status = (nand_flash -> lx_nand_flash_driver_pages_read)(block, start_page, LX_NULL, spare_buffer_ptr, pages);
+#endif
+
+        /* Check for an error from flash driver.   */
+        if (status)
+        {
+
+            /* Call system error handler.  */
+            _lx_nand_flash_system_error(nand_flash, status, block, 0);
+
+            /* Return an error.  */
+            return(LX_ERROR);
+        }
+
+        /* Loop to check the pages from the last one, the latest page of a sector takes priority.  */
+        while ((pages > 0) && (remaining_sectors > 0))
+        {
+
+            /* Move to the previous page.  */
+            pages--;
+
+            /* Get the spare data.  */
+            spare_data1 = LX_UTILITY_LONG_GET(&spare_buffer_ptr[pages * nand_flash -> lx_nand_flash_spare_total_length + nand_flash -> lx_nand_flash_spare_data1_offset]);
+
+            /* Get the offset of the sector in the run.  */
+            sector_offset = (spare_data1 & LX_NAND_PAGE_TYPE_USER_DATA_MASK) - logical_sector;
+
+            /* Check if the sector is in the run and not resolved yet.  */
+            if ((sector_offset < sector_count) && (page_list[sector_offset] == LX_NAND_SECTOR_PAGE_NOT_FOUND))
+            {
+
+                /* Set the page number.  */
+                page_list[sector_offset] = (USHORT)(start_page + pages);
+
+                /* Check if the sector is released.  */
+                if ((spare_data1 & ~LX_NAND_PAGE_TYPE_USER_DATA_MASK) == LX_NAND_PAGE_TYPE_USER_DATA_RELEASED)
+                {
+
+                    /* Set the released flag.  */
+                    page_list[sector_offset] |= LX_NAND_SECTOR_PAGE_RELEASED;
+                }
+
+                /* Decrease the remaining sectors.  */
+                remaining_sectors--;
+            }
+        }
+
+        /* Update the pages left to scan.  */
+        available_pages = start_page;
+    }
+
+    /* Return successful completion.  */
+    return(LX_SUCCESS);
+}
+
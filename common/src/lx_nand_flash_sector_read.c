@@ -64,9 +64,7 @@
 /*                                                                        */
 /*  CALLS                                                                 */
 /*                                                                        */
-/*    _lx_nand_flash_block_find             Find the mapped block         */
-/*    lx_nand_flash_driver_pages_read       Read pages                    */
-/*    _lx_nand_flash_system_error           Internal system error handler */
+/*    _lx_nand_flash_logical_group_read     Read sectors of one group     */
 /*    tx_mutex_get                          Get thread protection         */
 /*    tx_mutex_put                          Release thread protection     */
 /*                                                                        */
@@ -79,13 +77,7 @@ UINT  _lx_nand_flash_sector_read(LX_NAND_FLASH *nand_flash, ULONG logical_sector
 {
 
 UINT        status;
-ULONG       i;
-ULONG       *word_ptr;
-ULONG       block;
-USHORT      block_status;
-UCHAR       *spare_buffer_ptr;
-ULONG       available_pages;
-LONG        page;
+
 
 #ifdef LX_THREAD_SAFE_ENABLE
 
@@ -96,227 +88,8 @@ LONG        page;
     /* Increment the number of read requests.  */
     nand_flash -> lx_nand_flash_diagnostic_sector_read_requests++;
 
-    /* See if we can find the sector in the current mapping.  */
-    status = _lx_nand_flash_block_find(nand_flash, logical_sector, &block, &block_status);
-
-    /* Check return status.   */
-    if (status != LX_SUCCESS)
-    {
-
-        /* Call system error handler.  */
-        _lx_nand_flash_system_error(nand_flash, status, block, 0);
-
-        /* Determine if the error is fatal.  */
-        if (status != LX_NAND_ERROR_CORRECTED)
-        {
-#ifdef LX_THREAD_SAFE_ENABLE
-
-            /* Release the thread safe mutex.  */
-            tx_mutex_put(&nand_flash -> lx_nand_flash_mutex);
-#endif
-            /* Return an error.  */
-            return(LX_ERROR);
-        }
-    }
-
-    /* Determine if the block is mapped.  */
-    if (block != LX_NAND_BLOCK_UNMAPPED)
-    {
-
-        /* Setup spare buffer pointer.  */
-        spare_buffer_ptr = (UCHAR*)nand_flash -> lx_nand_flash_page_buffer;
-
-        /* Get available pages in this block.  */
-        available_pages = block_status & LX_NAND_BLOCK_STATUS_FULL ? nand_flash -> lx_nand_flash_pages_per_block : block_status & LX_NAND_BLOCK_STATUS_PAGE_NUMBER_MASK;
-
-        /* Determine if the pages are recorded sequentially.  */
-        if (block_status & LX_NAND_BLOCK_STATUS_NON_SEQUENTIAL)
-        {
-
-            /* Loop to search the logical page.  */
-            for (page = (LONG)available_pages - 1; page >= 0; page--)
-            {
-
-                /* Read a page.  */
-#ifdef LX_NAND_ENABLE_CONTROL_BLOCK_FOR_DRIVER_INTERFACE
-                status = (nand_flash -> lx_nand_flash_driver_pages_read)(nand_flash, block, (ULONG)page, (UCHAR*)NULL, spare_buffer_ptr, 1);
-#else
-                status = (nand_flash -> lx_nand_flash_driver_pages_read)(block, (ULONG)page, (UCHAR*)NULL, spare_buffer_ptr, 1);
-#endif
-
-                /* Check for an error from flash driver.   */
-                if (status)
-                {
-
-                    /* Call system error handler.  */
-                    _lx_nand_flash_system_error(nand_flash, status, block, 0);
-#ifdef LX_THREAD_SAFE_ENABLE
-
-                    /* Release the thread safe mutex.  */
-                    tx_mutex_put(&nand_flash -> lx_nand_flash_mutex);
-#endif
-                    /* Return an error.  */
-                    return(LX_ERROR);
-                }
-
-                /* Get the logical sector number from spare bytes, and check if it matches the addressed sector number.  */
-                if ((LX_UTILITY_LONG_GET(&spare_buffer_ptr[nand_flash -> lx_nand_flash_spare_data1_offset]) & LX_NAND_PAGE_TYPE_USER_DATA_MASK) == logical_sector)
-                {
-#ifdef LX_NAND_ENABLE_CONTROL_BLOCK_FOR_DRIVER_INTERFACE
-                    status = (nand_flash -> lx_nand_flash_driver_pages_read)(nand_flash, block, (ULONG)page, (UCHAR*)buffer, NULL, 1);
-#else
-                    status = (nand_flash -> lx_nand_flash_driver_pages_read)(block, (ULONG)page, (UCHAR*)buffer, NULL, 1);
-#endif
-
-                    /* Check for an error from flash driver.   */
-                    if (status)
-                    {
-
-                        /* Call system error handler.  */
-                        _lx_nand_flash_system_error(nand_flash, status, block, 0);
-#ifdef LX_THREAD_SAFE_ENABLE
-
-                        /* Release the thread safe mutex.  */
-                        tx_mutex_put(&nand_flash -> lx_nand_flash_mutex);
-#endif
-                        /* Return an error.  */
-                        return(LX_ERROR);
-                    }
-#ifdef LX_THREAD_SAFE_ENABLE
-
-                    /* Release the thread safe mutex.  */
-                    tx_mutex_put(&nand_flash -> lx_nand_flash_mutex);
-#endif
-                    /* Return successful completion.  */
-                    return(LX_SUCCESS);
-                }
-            }
-        }
-        else
-        {
-
-            /* Check if the logical sector is available.  */
-            if (logical_sector % nand_flash -> lx_nand_flash_pages_per_block < available_pages)
-            {
-
-                /* Read a page.  */
-#ifdef LX_NAND_ENABLE_CONTROL_BLOCK_FOR_DRIVER_INTERFACE
-                status = (nand_flash -> lx_nand_flash_driver_pages_read)(nand_flash, block, logical_sector % nand_flash -> lx_nand_flash_pages_per_block, (UCHAR*)buffer, spare_buffer_ptr, 1);
-#else
-                status = (nand_flash -> lx_nand_flash_driver_pages_read)(block, logical_sector % nand_flash -> lx_nand_flash_pages_per_block, (UCHAR*)buffer, spare_buffer_ptr, 1);
-#endif
-
-                /* Check for an error from flash driver.   */
-                if (status)
-                {
-
-                    /* Call system error handler.  */
-                    _lx_nand_flash_system_error(nand_flash, status, block, 0);
-
-#ifdef LX_THREAD_SAFE_ENABLE
-
-                    /* Release the thread safe mutex.  */
-                    tx_mutex_put(&nand_flash -> lx_nand_flash_mutex);
-#endif
-                    /* Return an error.  */
-                    return(LX_ERROR);
-                }
-#ifdef LX_THREAD_SAFE_ENABLE
-
-                /* Release the thread safe mutex.  */
-                tx_mutex_put(&nand_flash -> lx_nand_flash_mutex);
-#endif
-                /* Return successful completion.  */
-                return(LX_SUCCESS);
-            }
-        }
-    }
-
-#ifdef LX_NAND_FLASH_ENABLE_LAZY_SECTOR_RELEASE
-    {
-
-    ULONG   logical_group;
-    ULONG   old_block;
-
-    /* Check the compaction table for a deferred source block that might hold
-       the requested sector.  The primary block (tombstone block) was already
-       scanned above; fall back to the old full block here.  */
-    logical_group = logical_sector / nand_flash -> lx_nand_flash_pages_per_block;
-
-    if (nand_flash -> lx_nand_flash_block_compaction_table[logical_group] != (USHORT)LX_NAND_BLOCK_UNMAPPED)
-    {
-
-        old_block = nand_flash -> lx_nand_flash_block_compaction_table[logical_group];
-
-        /* Set spare buffer pointer.  */
-        spare_buffer_ptr = (UCHAR*)nand_flash -> lx_nand_flash_page_buffer;
-
-        /* The compaction-pending block is always FULL; scan all pages in reverse.  */
-        for (page = (LONG)nand_flash -> lx_nand_flash_pages_per_block - 1; page >= 0; page--)
-        {
-
-#ifdef LX_NAND_ENABLE_CONTROL_BLOCK_FOR_DRIVER_INTERFACE
-            status = (nand_flash -> lx_nand_flash_driver_pages_read)(nand_flash, old_block, (ULONG)page, (UCHAR*)NULL, spare_buffer_ptr, 1);
-#else
-            status = (nand_flash -> lx_nand_flash_driver_pages_read)(old_block, (ULONG)page, (UCHAR*)NULL, spare_buffer_ptr, 1);
-#endif
-
-            /* Check for an error from flash driver.  */
-            if (status)
-            {
-                _lx_nand_flash_system_error(nand_flash, status, old_block, 0);
-#ifdef LX_THREAD_SAFE_ENABLE
-                tx_mutex_put(&nand_flash -> lx_nand_flash_mutex);
-#endif
-                return(LX_ERROR);
-            }
-
-            /* Check if this page matches the requested sector.  */
-            if ((LX_UTILITY_LONG_GET(&spare_buffer_ptr[nand_flash -> lx_nand_flash_spare_data1_offset]) & LX_NAND_PAGE_TYPE_USER_DATA_MASK) == logical_sector)
-            {
-
-#ifdef LX_NAND_ENABLE_CONTROL_BLOCK_FOR_DRIVER_INTERFACE
-                status = (nand_flash -> lx_nand_flash_driver_pages_read)(nand_flash, old_block, (ULONG)page, (UCHAR*)buffer, NULL, 1);
-#else
-                status = (nand_flash -> lx_nand_flash_driver_pages_read)(old_block, (ULONG)page, (UCHAR*)buffer, NULL, 1);
-#endif
-
-                /* Check for an error from flash driver.  */
-                if (status)
-                {
-                    _lx_nand_flash_system_error(nand_flash, status, old_block, 0);
-#ifdef LX_THREAD_SAFE_ENABLE
-                    tx_mutex_put(&nand_flash -> lx_nand_flash_mutex);
-#endif
-                    return(LX_ERROR);
-                }
-
-#ifdef LX_THREAD_SAFE_ENABLE
-                tx_mutex_put(&nand_flash -> lx_nand_flash_mutex);
-#endif
-                return(LX_SUCCESS);
-            }
-        }
-    }
-
-    }
-#endif /* LX_NAND_FLASH_ENABLE_LAZY_SECTOR_RELEASE */
-
-    /* Sector hasn't been written. Simply fill the destination buffer with ones and return success.  */
-
-    /* Setup pointer to users buffer.  */
-    word_ptr =  (ULONG *) buffer;
-
-    /* Put all ones in he buffer.  */
-    for (i = 0; i < nand_flash -> lx_nand_flash_words_per_page; i++)
-    {
-
-        /* Copy a word.  */
-        *word_ptr++ =  LX_ALL_ONES;
-    }
-
-    /* Set the status to success.  */
-    status =  LX_SUCCESS;
+    /* Read the sector.  */
+    status = _lx_nand_flash_logical_group_read(nand_flash, logical_sector, (UCHAR*)buffer, 1);
 
 #ifdef LX_THREAD_SAFE_ENABLE
 
@@ -327,4 +100,3 @@ LONG        page;
     /* Return status.  */
     return(status);
 }
-
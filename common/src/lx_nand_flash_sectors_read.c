@@ -48,6 +48,8 @@
 /*  DESCRIPTION                                                           */
 /*                                                                        */
 /*    This function reads multiple logical sectors from NAND flash.       */
+/*    The sectors are split at logical group boundaries and each run is   */
+/*    read from its block with batched page reads.                        */
 /*                                                                        */
 /*  INPUT                                                                 */
 /*                                                                        */
@@ -64,7 +66,9 @@
 /*                                                                        */
 /*  CALLS                                                                 */
 /*                                                                        */
-/*    _lx_nand_flash_sector_read            Read a sector                 */
+/*    _lx_nand_flash_logical_group_read     Read sectors of one group     */
+/*    tx_mutex_get                          Get thread protection         */
+/*    tx_mutex_put                          Release thread protection     */
 /*                                                                        */
 /*  CALLED BY                                                             */
 /*                                                                        */
@@ -74,16 +78,38 @@
 UINT  _lx_nand_flash_sectors_read(LX_NAND_FLASH *nand_flash, ULONG logical_sector, VOID *buffer, ULONG sector_count)
 {
 
-UINT status = LX_SUCCESS;
-UINT i;
+UINT    status = LX_SUCCESS;
+ULONG   sectors;
+UCHAR   *buffer_ptr;
 
 
+#ifdef LX_THREAD_SAFE_ENABLE
+
+    /* Obtain the thread safe mutex.  */
+    tx_mutex_get(&nand_flash -> lx_nand_flash_mutex, TX_WAIT_FOREVER);
+#endif
+
+    /* Setup buffer pointer.  */
+    buffer_ptr = (UCHAR*)buffer;
+
     /* Loop to read all the sectors.  */
-    for (i = 0; i < sector_count; i++)
+    while (sector_count)
     {
 
-        /* Read one sector.  */
-        status = _lx_nand_flash_sector_read(nand_flash, logical_sector + i, ((UCHAR*)buffer) + i * nand_flash -> lx_nand_flash_bytes_per_page);
+        /* Calculate the number of sectors left in this logical group.  */
+        sectors = nand_flash -> lx_nand_flash_pages_per_block - (logical_sector % nand_flash -> lx_nand_flash_pages_per_block);
+
+        /* Limit the sectors to the remaining sector count.  */
+        if (sectors > sector_count)
+        {
+            sectors = sector_count;
+        }
+
+        /* Increment the number of read requests.  */
+        nand_flash -> lx_nand_flash_diagnostic_sector_read_requests += sectors;
+
+        /* Read the sectors of this logical group.  */
+        status = _lx_nand_flash_logical_group_read(nand_flash, logical_sector, buffer_ptr, sectors);
 
         /* Check return status.  */
         if (status)
@@ -92,9 +118,19 @@ UINT i;
             /* Error, break the loop.  */
             break;
         }
+
+        /* Move to the next logical group.  */
+        logical_sector += sectors;
+        buffer_ptr += sectors * nand_flash -> lx_nand_flash_bytes_per_page;
+        sector_count -= sectors;
     }
 
+#ifdef LX_THREAD_SAFE_ENABLE
+
+    /* Release the thread safe mutex.  */
+    tx_mutex_put(&nand_flash -> lx_nand_flash_mutex);
+#endif
+
     /* Return status.  */
     return(status);
 }
-
@@ -62,7 +62,10 @@
 /*                                                                        */
 /*  CALLS                                                                 */
 /*                                                                        */
-/*    _lx_nand_flash_sector_release         Release one sector            */
+/*    _lx_nand_flash_logical_sector_release Release one sector            */
+/*    _lx_nand_flash_metadata_flush         Flush metadata updates        */
+/*    tx_mutex_get                          Get thread protection         */
+/*    tx_mutex_put                          Release thread protection     */
 /*                                                                        */
 /*  CALLED BY                                                             */
 /*                                                                        */
@@ -76,12 +79,21 @@ UINT status = LX_SUCCESS;
 UINT i;
 
 
+#ifdef LX_THREAD_SAFE_ENABLE
+
+    /* Obtain the thread safe mutex.  */
+    tx_mutex_get(&nand_flash -> lx_nand_flash_mutex, TX_WAIT_FOREVER);
+#endif
+
     /* Loop to release all the sectors.  */
     for (i = 0; i < sector_count; i++)
     {
 
+        /* Increment the number of release requests.  */
+        nand_flash -> lx_nand_flash_diagnostic_sector_release_requests++;
+
         /* Release one sector.  */
-        status = _lx_nand_flash_sector_release(nand_flash, logical_sector + i);
+        status = _lx_nand_flash_logical_sector_release(nand_flash, logical_sector + i);
 
         /* Check return status.  */
         if (status)
@@ -92,7 +104,19 @@ UINT i;
         }
     }
 
+    /* Write the metadata updates of all the released sectors at once.  */
+    if (_lx_nand_flash_metadata_flush(nand_flash) != LX_SUCCESS)
+    {
+
+        /* Return an error.  */
+        status = LX_ERROR;
+    }
+#ifdef LX_THREAD_SAFE_ENABLE
+
+    /* Release the thread safe mutex.  */
+    tx_mutex_put(&nand_flash -> lx_nand_flash_mutex);
+#endif
+
     /* Return status.  */
     return(status);
 }
-
@@ -48,6 +48,8 @@
 /*  DESCRIPTION                                                           */
 /*                                                                        */
 /*    This function writes multiple logical sectors to the NAND flash.    */
+/*    The sectors are split at logical group boundaries and each run is   */
+/*    written to its block with batched page writes.                      */
 /*                                                                        */
 /*  INPUT                                                                 */
 /*                                                                        */
@@ -64,7 +66,10 @@
 /*                                                                        */
 /*  CALLS                                                                 */
 /*                                                                        */
-/*    _lx_nand_flash_sector_write           Write one sector              */
+/*    _lx_nand_flash_logical_group_write    Write sectors of one group    */
+/*    _lx_nand_flash_metadata_flush         Flush metadata updates        */
+/*    tx_mutex_get                          Get thread protection         */
+/*    tx_mutex_put                          Release thread protection     */
 /*                                                                        */
 /*  CALLED BY                                                             */
 /*                                                                        */
@@ -74,16 +79,38 @@
 UINT  _lx_nand_flash_sectors_write(LX_NAND_FLASH *nand_flash, ULONG logical_sector, VOID *buffer, ULONG sector_count)
 {
 
-UINT status = LX_SUCCESS;
-UINT i;
+UINT    status = LX_SUCCESS;
+ULONG   sectors;
+UCHAR   *buffer_ptr;
 
 
+#ifdef LX_THREAD_SAFE_ENABLE
+
+    /* Obtain the thread safe mutex.  */
+    tx_mutex_get(&nand_flash -> lx_nand_flash_mutex, TX_WAIT_FOREVER);
+#endif
+
+    /* Setup buffer pointer.  */
+    buffer_ptr = (UCHAR*)buffer;
+
     /* Loop to write all the sectors.  */
-    for (i = 0; i < sector_count; i++)
+    while (sector_count)
     {
 
-        /* Write one sector.  */
-        status = _lx_nand_flash_sector_write(nand_flash, logical_sector + i, ((UCHAR*)buffer) + i * nand_flash -> lx_nand_flash_bytes_per_page);
+        /* Calculate the number of sectors left in this logical group.  */
+        sectors = nand_flash -> lx_nand_flash_pages_per_block - (logical_sector % nand_flash -> lx_nand_flash_pages_per_block);
+
+        /* Limit the sectors to the remaining sector count.  */
+        if (sectors > sector_count)
+        {
+            sectors = sector_count;
+        }
+
+        /* Increment the number of write requests.  */
+        nand_flash -> lx_nand_flash_diagnostic_sector_write_requests += sectors;
+
+        /* Write the sectors of this logical group.  */
+        status = _lx_nand_flash_logical_group_write(nand_flash, logical_sector, buffer_ptr, sectors);
 
         /* Check return status.  */
         if (status)
@@ -92,10 +119,27 @@ UINT i;
             /* Error, break the loop.  */
             break;
         }
+
+        /* Move to the next logical group.  */
+        logical_sector += sectors;
+        buffer_ptr += sectors * nand_flash -> lx_nand_flash_bytes_per_page;
+        sector_count -= sectors;
     }
 
+    /* Write the metadata updates of the request.  */
+    if (_lx_nand_flash_metadata_flush(nand_flash) != LX_SUCCESS)
+    {
+
+        /* Return an error.  */
+        status = LX_ERROR;
+    }
+
+#ifdef LX_THREAD_SAFE_ENABLE
+
+    /* Release the thread safe mutex.  */
+    tx_mutex_put(&nand_flash -> lx_nand_flash_mutex);
+#endif
+
     /* Return status.  */
     return(status);
 }
-
-
@@ -27,6 +27,9 @@ UCHAR                   thread_0_stack[DEMO_STACK_SIZE];
 #ifdef EXTENDED_CACHE
 UCHAR                   cache_memory[50000];
 #endif
+#ifndef LX_NAND_DISABLE_EXTENDED_CACHE
+UCHAR                   group_cache_memory[2048];
+#endif
 
 /* Define LevelX structures.  */
 
@@ -514,7 +517,10 @@ UCHAR   *byte_ptr;
 
     status =  lx_nand_flash_defragment(&nand_sim_flash);
 
-    if (status != LX_NOT_SUPPORTED)
+    /* Only the latest page of the 9 sectors written is left in the block.  */
+    if ((status != LX_SUCCESS) ||
+        (nand_sim_flash.lx_nand_flash_block_status_table[nand_sim_flash.lx_nand_flash_block_mapping_table[0]] & LX_NAND_BLOCK_STATUS_FULL) ||
+        ((nand_sim_flash.lx_nand_flash_block_status_table[nand_sim_flash.lx_nand_flash_block_mapping_table[0]] & LX_NAND_BLOCK_STATUS_PAGE_NUMBER_MASK) != 9))
     {
           printf("FAILED!\n");
 #ifdef BATCH_TEST
@@ -824,6 +830,765 @@ UCHAR   *byte_ptr;
 
     printf("SUCCESS!\n");
 
+    printf("Test 5: Multi-sector write-read test............");
+
+    /* Reinitialize...  */
+    _lx_nand_flash_simulator_erase_all();
+
+    lx_nand_flash_initialize();
+
+    status = lx_nand_flash_format(&nand_sim_flash, "sim nand flash", _lx_nand_flash_simulator_initialize, nand_memory_space, sizeof(nand_memory_space));
+    status += lx_nand_flash_open(&nand_sim_flash, "sim nand flash", _lx_nand_flash_simulator_initialize, nand_memory_space, sizeof(nand_memory_space));
+
+    /* Build the data of 1024 sectors, each sector is filled with its sector number.  */
+    for (i = 0; i < 1024; i++)
+    {
+        for (j = 0; j < SECTOR_SIZE / sizeof(ULONG); j++)
+            ((ULONG *)local_data_buffer)[i * (SECTOR_SIZE / sizeof(ULONG)) + j] = i;
+    }
+
+    /* Write sectors across several logical groups.  */
+    status += lx_nand_flash_sectors_write(&nand_sim_flash, 100, local_data_buffer + 100 * SECTOR_SIZE, 700);
+
+    /* Overwrite the middle of the range so the full block of logical group 1 is copied.  */
+    for (i = 200; i < 450; i++)
+        ((ULONG *)local_data_buffer)[i * (SECTOR_SIZE / sizeof(ULONG))] = i + 0x10000;
+    status += lx_nand_flash_sectors_write(&nand_sim_flash, 200, local_data_buffer + 200 * SECTOR_SIZE, 250);
+
+    if ((status != LX_SUCCESS) ||
+        (nand_sim_flash.lx_nand_flash_block_status_table[nand_sim_flash.lx_nand_flash_block_mapping_table[1]] & LX_NAND_BLOCK_STATUS_NON_SEQUENTIAL))
+    {
+        printf("FAILED!\n");
+#ifdef BATCH_TEST
+        exit(1);
+#endif
+        while (1)
+        {
+        }
+    }
+
+    /* Close and reopen the flash.  */
+    status = lx_nand_flash_close(&nand_sim_flash);
+    status += lx_nand_flash_open(&nand_sim_flash, "sim nand flash", _lx_nand_flash_simulator_initialize, nand_memory_space, sizeof(nand_memory_space));
+
+    /* Read back the sectors one by one.  */
+    for (i = 0; i < 1024; i++)
+    {
+        status += lx_nand_flash_sector_read(&nand_sim_flash, i, readbuffer);
+
+        if ((status != LX_SUCCESS) ||
+            (readbuffer[0] != (((i >= 100) && (i < 800)) ? ((ULONG *)local_data_buffer)[i * (SECTOR_SIZE / sizeof(ULONG))] : 0xFFFFFFFF)))
+        {
+            printf("FAILED!\n");
+#ifdef BATCH_TEST
+            exit(1);
+#endif
+            while (1)
+            {
+            }
+        }
+    }
+
+    /* Read back all the sectors at once.  */
+    status = lx_nand_flash_sectors_read(&nand_sim_flash, 0, local_data_buffer + 1024 * SECTOR_SIZE, 1024);
+
+    for (i = 0; i < 1024; i++)
+    {
+        if ((status != LX_SUCCESS) ||
+            (((ULONG *)local_data_buffer)[(1024 + i) * (SECTOR_SIZE / sizeof(ULONG))] != (((i >= 100) && (i < 800)) ? ((ULONG *)local_data_buffer)[i * (SECTOR_SIZE / sizeof(ULONG))] : 0xFFFFFFFF)))
+        {
+            printf("FAILED!\n");
+#ifdef BATCH_TEST
+            exit(1);
+#endif
+            while (1)
+            {
+            }
+        }
+    }
+
+    status = lx_nand_flash_close(&nand_sim_flash);
+
+    if (status != LX_SUCCESS)
+    {
+          printf("FAILED!\n");
+#ifdef BATCH_TEST
+    exit(1);
+#endif
+          while(1)
+          {
+          }
+    }
+    printf("SUCCESS!\n");
+
+#ifndef LX_NAND_DISABLE_EXTENDED_CACHE
+    printf("Test 6: Extended cache test.....................");
+
+    /* Reinitialize...  */
+    _lx_nand_flash_simulator_erase_all();
+
+    lx_nand_flash_initialize();
+
+    status = lx_nand_flash_format(&nand_sim_flash, "sim nand flash", _lx_nand_flash_simulator_initialize, nand_memory_space, sizeof(nand_memory_space));
+    status += lx_nand_flash_open(&nand_sim_flash, "sim nand flash", _lx_nand_flash_simulator_initialize, nand_memory_space, sizeof(nand_memory_space));
+
+    /* The cache memory must hold at least the page list of one logical group.  */
+    if ((status != LX_SUCCESS) ||
+        (lx_nand_flash_extended_cache_enable(&nand_sim_flash, group_cache_memory, 2) != LX_ERROR))
+    {
+        printf("FAILED!\n");
+#ifdef BATCH_TEST
+        exit(1);
+#endif
+        while (1)
+        {
+        }
+    }
+
+    /* Enable the cache of 4 logical groups.  */
+    status = lx_nand_flash_extended_cache_enable(&nand_sim_flash, group_cache_memory, sizeof(group_cache_memory));
+
+    /* Write 100 sectors of logical group 2 backward so the block is not sequential.  */
+    for (i = 611; i >= 512; i--)
+    {
+        buffer[0] = i;
+        status += lx_nand_flash_sector_write(&nand_sim_flash, i, buffer);
+    }
+
+    /* Overwrite and release some sectors in the same block.  */
+    for (i = 550; i < 560; i++)
+    {
+        buffer[0] = i + 0x10000;
+        status += lx_nand_flash_sector_write(&nand_sim_flash, i, buffer);
+    }
+    for (i = 520; i < 530; i++)
+    {
+        status += lx_nand_flash_sector_release(&nand_sim_flash, i);
+    }
+
+    /* Write two sectors backward in logical groups 3 to 8, more than the cache holds.  */
+    for (i = 3; i <= 8; i++)
+    {
+        buffer[0] = i * 256 + 1;
+        status += lx_nand_flash_sector_write(&nand_sim_flash, i * 256 + 1, buffer);
+        buffer[0] = i * 256;
+        status += lx_nand_flash_sector_write(&nand_sim_flash, i * 256, buffer);
+    }
+
+    /* Read back all the sectors twice, the second pass comes from the cache.  */
+    for (j = 0; j < 2; j++)
+    {
+        for (i = 512; i < 612; i++)
+        {
+            status += lx_nand_flash_sector_read(&nand_sim_flash, i, readbuffer);
+
+            if ((status != LX_SUCCESS) ||
+                (readbuffer[0] != (((i >= 520) && (i < 530)) ? 0xFFFFFFFF : ((i >= 550) && (i < 560)) ? i + 0x10000 : i)))
+            {
+                printf("FAILED!\n");
+#ifdef BATCH_TEST
+                exit(1);
+#endif
+                while (1)
+                {
+                }
+            }
+        }
+        for (i = 3 * 256; i <= 8 * 256 + 1; i++)
+        {
+            status += lx_nand_flash_sector_read(&nand_sim_flash, i, readbuffer);
+
+            if ((status != LX_SUCCESS) ||
+                (readbuffer[0] != (((i % 256) < 2) ? i : 0xFFFFFFFF)))
+            {
+                printf("FAILED!\n");
+#ifdef BATCH_TEST
+                exit(1);
+#endif
+                while (1)
+                {
+                }
+            }
+        }
+    }
+
+    /* Release a sector from the cached list, overwrite another and read them back.  */
+    status += lx_nand_flash_sector_release(&nand_sim_flash, 600);
+    buffer[0] = 0x20000;
+    status += lx_nand_flash_sector_write(&nand_sim_flash, 520, buffer);
+    status += lx_nand_flash_sectors_read(&nand_sim_flash, 512, local_data_buffer, 100);
+
+    if ((status != LX_SUCCESS) ||
+        (nand_sim_flash.lx_nand_flash_extended_cache_hits == 0) ||
+        (nand_sim_flash.lx_nand_flash_extended_cache_misses == 0) ||
+        (((ULONG *)local_data_buffer)[(600 - 512) * (SECTOR_SIZE / sizeof(ULONG))] != 0xFFFFFFFF) ||
+        (((ULONG *)local_data_buffer)[(520 - 512) * (SECTOR_SIZE / sizeof(ULONG))] != 0x20000) ||
+        (((ULONG *)local_data_buffer)[(555 - 512) * (SECTOR_SIZE / sizeof(ULONG))] != 555 + 0x10000) ||
+        (((ULONG *)local_data_buffer)[(611 - 512) * (SECTOR_SIZE / sizeof(ULONG))] != 611))
+    {
+        printf("FAILED!\n");
+#ifdef BATCH_TEST
+        exit(1);
+#endif
+        while (1)
+        {
+        }
+    }
+
+    /* Disable the cache.  */
+    status = lx_nand_flash_extended_cache_enable(&nand_sim_flash, LX_NULL, 0);
+    status += lx_nand_flash_sector_read(&nand_sim_flash, 520, readbuffer);
+    if ((status != LX_SUCCESS) || (readbuffer[0] != 0x20000) ||
+        (nand_sim_flash.lx_nand_flash_extended_cache_entries != 0))
+    {
+        printf("FAILED!\n");
+#ifdef BATCH_TEST
+        exit(1);
+#endif
+        while (1)
+        {
+        }
+    }
+
+    status = lx_nand_flash_close(&nand_sim_flash);
+
+    if (status != LX_SUCCESS)
+    {
+          printf("FAILED!\n");
+#ifdef BATCH_TEST
+    exit(1);
+#endif
+          while(1)
+          {
+          }
+    }
+    printf("SUCCESS!\n");
+#endif
+
+    printf("Test 7: Partial defragment test.................");
+
+    /* Reinitialize...  */
+    _lx_nand_flash_simulator_erase_all();
+
+    lx_nand_flash_initialize();
+
+    status = lx_nand_flash_format(&nand_sim_flash, "sim nand flash", _lx_nand_flash_simulator_initialize, nand_memory_space, sizeof(nand_memory_space));
+    status += lx_nand_flash_open(&nand_sim_flash, "sim nand flash", _lx_nand_flash_simulator_initialize, nand_memory_space, sizeof(nand_memory_space));
+
+    /* Fill logical groups 1 and 2 with sectors written twice, and release half of group 3.  */
+    for (i = 0; i < 256; i++)
+    {
+        buffer[0] = i;
+        status += lx_nand_flash_sector_write(&nand_sim_flash, 256 + (i % 128), buffer);
+        status += lx_nand_flash_sector_write(&nand_sim_flash, 512 + (i % 128), buffer);
+    }
+    for (i = 768; i < 1024; i++)
+    {
+        buffer[0] = i;
+        status += lx_nand_flash_sector_write(&nand_sim_flash, i, buffer);
+    }
+    for (i = 768; i < 896; i++)
+    {
+        status += lx_nand_flash_sector_release(&nand_sim_flash, i);
+    }
+
+    /* Defragment one block, the first full block is rewritten sequentially and the next call resumes after it.  */
+    status += lx_nand_flash_partial_defragment(&nand_sim_flash, 1);
+
+    if ((status != LX_SUCCESS) || (nand_sim_flash.lx_nand_flash_defragment_logical_group != 2) ||
+        (nand_sim_flash.lx_nand_flash_block_status_table[nand_sim_flash.lx_nand_flash_block_mapping_table[1]] != (LX_NAND_BLOCK_STATUS_ALLOCATED | 128)) ||
+        ((nand_sim_flash.lx_nand_flash_block_status_table[nand_sim_flash.lx_nand_flash_block_mapping_table[2]] & LX_NAND_BLOCK_STATUS_NON_SEQUENTIAL) == 0))
+    {
+        printf("FAILED!\n");
+#ifdef BATCH_TEST
+        exit(1);
+#endif
+        while (1)
+        {
+        }
+    }
+
+    /* Defragment the rest.  */
+    status = lx_nand_flash_partial_defragment(&nand_sim_flash, 10);
+
+    if ((status != LX_SUCCESS) ||
+        (nand_sim_flash.lx_nand_flash_block_status_table[nand_sim_flash.lx_nand_flash_block_mapping_table[2]] != (LX_NAND_BLOCK_STATUS_ALLOCATED | 128)) ||
+        ((nand_sim_flash.lx_nand_flash_block_status_table[nand_sim_flash.lx_nand_flash_block_mapping_table[3]] & LX_NAND_BLOCK_STATUS_PAGE_NUMBER_MASK) != 128))
+    {
+        printf("FAILED!\n");
+#ifdef BATCH_TEST
+        exit(1);
+#endif
+        while (1)
+        {
+        }
+    }
+
+    /* Read back the sectors.  */
+    for (i = 256; i < 1024; i++)
+    {
+        status = lx_nand_flash_sector_read(&nand_sim_flash, i, readbuffer);
+
+        if ((status != LX_SUCCESS) ||
+            (readbuffer[0] != ((i < 768) ? (((i % 256) < 128) ? (i % 256) + 128 : 0xFFFFFFFF) : ((i < 896) ? 0xFFFFFFFF : i))))
+        {
+            printf("FAILED!\n");
+#ifdef BATCH_TEST
+            exit(1);
+#endif
+            while (1)
+            {
+            }
+        }
+    }
+
+    status = lx_nand_flash_close(&nand_sim_flash);
+
+    if (status != LX_SUCCESS)
+    {
+          printf("FAILED!\n");
+#ifdef BATCH_TEST
+    exit(1);
+#endif
+          while(1)
+          {
+          }
+    }
+    printf("SUCCESS!\n");
+
+    printf("Test 8: Metadata flush test.....................");
+
+    /* Reinitialize...  */
+    _lx_nand_flash_simulator_erase_all();
+
+    lx_nand_flash_initialize();
+
+    status = lx_nand_flash_format(&nand_sim_flash, "sim nand flash", _lx_nand_flash_simulator_initialize, nand_memory_space, sizeof(nand_memory_space));
+    status += lx_nand_flash_open(&nand_sim_flash, "sim nand flash", _lx_nand_flash_simulator_initialize, nand_memory_space, sizeof(nand_memory_space));
+
+    /* Write the first sectors of logical group 4.  */
+    for (i = 1024; i < 1034; i++)
+    {
+        buffer[0] = i;
+        status += lx_nand_flash_sector_write(&nand_sim_flash, i, buffer);
+    }
+
+    /* Release 8 sectors, the status updates are written once at the end of the request.  */
+    j = nand_sim_flash.lx_nand_flash_metadata_block_count * nand_sim_flash.lx_nand_flash_pages_per_block + nand_sim_flash.lx_nand_flash_metadata_block_current_page;
+    status += lx_nand_flash_sectors_release(&nand_sim_flash, 1024, 8);
+    j = nand_sim_flash.lx_nand_flash_metadata_block_count * nand_sim_flash.lx_nand_flash_pages_per_block + nand_sim_flash.lx_nand_flash_metadata_block_current_page - j;
+
+    if ((status != LX_SUCCESS) || (j > 2))
+    {
+        printf("FAILED!\n");
+#ifdef BATCH_TEST
+        exit(1);
+#endif
+        while (1)
+        {
+        }
+    }
+
+    /* Write more sectors without flushing the status, then drop the pending updates to simulate a power loss.  */
+    for (i = 1034; i < 1039; i++)
+    {
+        buffer[0] = i;
+        status += _lx_nand_flash_logical_group_write(&nand_sim_flash, i, (UCHAR *) buffer, 1);
+    }
+    memset(nand_sim_flash.lx_nand_flash_block_status_dirty_pages, 0, sizeof(nand_sim_flash.lx_nand_flash_block_status_dirty_pages));
+    memset(nand_sim_flash.lx_nand_flash_erase_count_dirty_pages, 0, sizeof(nand_sim_flash.lx_nand_flash_erase_count_dirty_pages));
+#ifdef LX_NAND_ENABLE_METADATA_DELTA
+    nand_sim_flash.lx_nand_flash_metadata_delta_count = 0;
+#endif
+#ifndef LX_NAND_DISABLE_FAST_MOUNT
+    memset(nand_sim_flash.lx_nand_flash_anchor_block, 0xFF, sizeof(nand_sim_flash.lx_nand_flash_anchor_block));
+#endif
+    status += lx_nand_flash_close(&nand_sim_flash);
+
+    /* Reopen, the status of the block is rebuilt from its pages.  */
+    status += lx_nand_flash_open(&nand_sim_flash, "sim nand flash", _lx_nand_flash_simulator_initialize, nand_memory_space, sizeof(nand_memory_space));
+    sector = nand_sim_flash.lx_nand_flash_block_mapping_table[4];
+
+    if ((status != LX_SUCCESS) ||
+        (nand_sim_flash.lx_nand_flash_block_status_table[sector] != (LX_NAND_BLOCK_STATUS_ALLOCATED | LX_NAND_BLOCK_STATUS_NON_SEQUENTIAL | 23)))
+    {
+        printf("FAILED!\n");
+#ifdef BATCH_TEST
+        exit(1);
+#endif
+        while (1)
+        {
+        }
+    }
+
+    /* Write one more sector after the recovered pages.  */
+    buffer[0] = 1039;
+    status = lx_nand_flash_sector_write(&nand_sim_flash, 1039, buffer);
+
+    /* Read back the sectors.  */
+    for (i = 1024; i < 1040; i++)
+    {
+        status += lx_nand_flash_sector_read(&nand_sim_flash, i, readbuffer);
+
+        if ((status != LX_SUCCESS) || (readbuffer[0] != ((i < 1032) ? 0xFFFFFFFF : i)))
+        {
+            printf("FAILED!\n");
+#ifdef BATCH_TEST
+            exit(1);
+#endif
+            while (1)
+            {
+            }
+        }
+    }
+
+    status = lx_nand_flash_close(&nand_sim_flash);
+
+    if (status != LX_SUCCESS)
+    {
+        printf("FAILED!\n");
+#ifdef BATCH_TEST
+        exit(1);
+#endif
+        while (1)
+        {
+        }
+    }
+    printf("SUCCESS!\n");
+
+    printf("Test 9: Metadata delta test.....................");
+
+    /* Reinitialize...  */
+    _lx_nand_flash_simulator_erase_all();
+
+    lx_nand_flash_initialize();
+
+    status = lx_nand_flash_format(&nand_sim_flash, "sim nand flash", _lx_nand_flash_simulator_initialize, nand_memory_space, sizeof(nand_memory_space));
+    status += lx_nand_flash_open(&nand_sim_flash, "sim nand flash", _lx_nand_flash_simulator_initialize, nand_memory_space, sizeof(nand_memory_space));
+
+    /* Fill logical group 5 and the start of group 6.  */
+    for (i = 1280; i < 1600; i++)
+    {
+        buffer[0] = i;
+        status += lx_nand_flash_sector_write(&nand_sim_flash, i, buffer);
+    }
+
+    /* Overwrite a sector of the full block. The new block status and mapping, then the erase count and
+       status of the old block are written as two delta pages.  */
+    j = nand_sim_flash.lx_nand_flash_metadata_block_count * nand_sim_flash.lx_nand_flash_pages_per_block + nand_sim_flash.lx_nand_flash_metadata_block_current_page;
+    buffer[0] = 0x5A5A;
+    status += lx_nand_flash_sector_write(&nand_sim_flash, 1300, buffer);
+    j = nand_sim_flash.lx_nand_flash_metadata_block_count * nand_sim_flash.lx_nand_flash_pages_per_block + nand_sim_flash.lx_nand_flash_metadata_block_current_page - j;
+
+    if ((status != LX_SUCCESS)
+#ifdef LX_NAND_ENABLE_METADATA_DELTA
+        || (j != 2)
+#endif
+        )
+    {
+        printf("FAILED!\n");
+#ifdef BATCH_TEST
+        exit(1);
+#endif
+        while (1)
+        {
+        }
+    }
+
+    /* Release a few sectors and save the tables.  */
+    status = lx_nand_flash_sectors_release(&nand_sim_flash, 1590, 10);
+    memcpy(buffer, nand_sim_flash.lx_nand_flash_block_mapping_table, nand_sim_flash.lx_nand_flash_total_blocks * sizeof(USHORT));
+    memcpy(readbuffer, nand_sim_flash.lx_nand_flash_block_status_table, nand_sim_flash.lx_nand_flash_total_blocks * sizeof(USHORT));
+    memcpy(&buffer[1024], nand_sim_flash.lx_nand_flash_erase_count_table, nand_sim_flash.lx_nand_flash_total_blocks);
+    status += lx_nand_flash_close(&nand_sim_flash);
+
+    /* Reopen, the tables are rebuilt from the table pages and the delta pages.  */
+    status += lx_nand_flash_open(&nand_sim_flash, "sim nand flash", _lx_nand_flash_simulator_initialize, nand_memory_space, sizeof(nand_memory_space));
+
+    if ((status != LX_SUCCESS) ||
+        (memcmp(buffer, nand_sim_flash.lx_nand_flash_block_mapping_table, nand_sim_flash.lx_nand_flash_total_blocks * sizeof(USHORT)) != 0) ||
+        (memcmp(readbuffer, nand_sim_flash.lx_nand_flash_block_status_table, nand_sim_flash.lx_nand_flash_total_blocks * sizeof(USHORT)) != 0) ||
+        (memcmp(&buffer[1024], nand_sim_flash.lx_nand_flash_erase_count_table, nand_sim_flash.lx_nand_flash_total_blocks) != 0))
+    {
+        printf("FAILED!\n");
+#ifdef BATCH_TEST
+        exit(1);
+#endif
+        while (1)
+        {
+        }
+    }
+
+#ifdef LX_NAND_ENABLE_METADATA_DELTA
+
+    /* A delta page must continue the record numbers of the delta pages before it.  */
+    j = nand_sim_flash.lx_nand_flash_metadata_delta_sequence;
+    memset(byte_buffer, 0xFF, sizeof(byte_buffer));
+    byte_buffer[LX_NAND_METADATA_DELTA_TABLE_OFFSET] = LX_NAND_METADATA_DELTA_BLOCK_STATUS;
+    LX_UTILITY_SHORT_SET(&byte_buffer[LX_NAND_METADATA_DELTA_INDEX_OFFSET], 0);
+    LX_UTILITY_SHORT_SET(&byte_buffer[LX_NAND_METADATA_DELTA_VALUE_OFFSET], nand_sim_flash.lx_nand_flash_block_status_table[0]);
+    LX_UTILITY_SHORT_SET(&byte_buffer[LX_NAND_METADATA_DELTA_SEQUENCE_OFFSET], j + 1);
+    status = _lx_nand_flash_metadata_delta_apply(&nand_sim_flash, byte_buffer);
+    LX_UTILITY_SHORT_SET(&byte_buffer[LX_NAND_METADATA_DELTA_SEQUENCE_OFFSET], j);
+    status += _lx_nand_flash_metadata_delta_apply(&nand_sim_flash, byte_buffer);
+
+    if ((j == 0) || (status != LX_ERROR) || (nand_sim_flash.lx_nand_flash_metadata_delta_sequence != j + 1))
+    {
+        printf("FAILED!\n");
+#ifdef BATCH_TEST
+        exit(1);
+#endif
+        while (1)
+        {
+        }
+    }
+#endif
+
+    /* Read back the sectors.  */
+    for (i = 1280; i < 1600; i++)
+    {
+        status = lx_nand_flash_sector_read(&nand_sim_flash, i, readbuffer);
+
+        if ((status != LX_SUCCESS) || (readbuffer[0] != ((i == 1300) ? 0x5A5A : ((i < 1590) ? i : 0xFFFFFFFF))))
+        {
+            printf("FAILED!\n");
+#ifdef BATCH_TEST
+            exit(1);
+#endif
+            while (1)
+            {
+            }
+        }
+    }
+
+    status = lx_nand_flash_close(&nand_sim_flash);
+
+    if (status != LX_SUCCESS)
+    {
+        printf("FAILED!\n");
+#ifdef BATCH_TEST
+        exit(1);
+#endif
+        while (1)
+        {
+        }
+    }
+    printf("SUCCESS!\n");
+
+    printf("Test 10: Fast mount test........................");
+
+    /* Reinitialize...  */
+    _lx_nand_flash_simulator_erase_all();
+
+    lx_nand_flash_initialize();
+
+    status = lx_nand_flash_format(&nand_sim_flash, "sim nand flash", _lx_nand_flash_simulator_initialize, nand_memory_space, sizeof(nand_memory_space));
+    status += lx_nand_flash_open(&nand_sim_flash, "sim nand flash", _lx_nand_flash_simulator_initialize, nand_memory_space, sizeof(nand_memory_space));
+
+    /* Overwrite a few sectors until the metadata is rebuilt in other blocks.  */
+    sector = nand_sim_flash.lx_nand_flash_metadata_block_number;
+    for (i = 0; (i < 4000) && (nand_sim_flash.lx_nand_flash_metadata_block_number == sector); i++)
+    {
+        buffer[0] = i;
+        status += lx_nand_flash_sector_write(&nand_sim_flash, 2048 + (i % 8), buffer);
+    }
+
+    /* Write the final data of the sectors.  */
+    for (i = 2048; i < 2056; i++)
+    {
+        buffer[0] = i;
+        status += lx_nand_flash_sector_write(&nand_sim_flash, i, buffer);
+    }
+
+    /* Close and reopen, the metadata is found through the anchor.  */
+    sector = nand_sim_flash.lx_nand_flash_metadata_block_number;
+    status += lx_nand_flash_close(&nand_sim_flash);
+    status += lx_nand_flash_open(&nand_sim_flash, "sim nand flash", _lx_nand_flash_simulator_initialize, nand_memory_space, sizeof(nand_memory_space));
+
+    if ((status != LX_SUCCESS) || (nand_sim_flash.lx_nand_flash_metadata_block_number != sector)
+#ifndef LX_NAND_DISABLE_FAST_MOUNT
+        || (nand_sim_flash.lx_nand_flash_anchor_block[0] != 0) || (nand_sim_flash.lx_nand_flash_anchor.lx_nand_anchor_state != LX_NAND_ANCHOR_STATE_MOUNTED)
+        || (nand_sim_flash.lx_nand_flash_diagnostic_block_status_gets > LX_NAND_ANCHOR_BLOCKS)
+#endif
+        )
+    {
+        printf("FAILED!\n");
+#ifdef BATCH_TEST
+        exit(1);
+#endif
+        while (1)
+        {
+        }
+    }
+
+    /* Read back the sectors.  */
+    for (i = 2048; i < 2056; i++)
+    {
+        status = lx_nand_flash_sector_read(&nand_sim_flash, i, readbuffer);
+
+        if ((status != LX_SUCCESS) || (readbuffer[0] != i))
+        {
+            printf("FAILED!\n");
+#ifdef BATCH_TEST
+            exit(1);
+#endif
+            while (1)
+            {
+            }
+        }
+    }
+
+    /* Write the first sectors of logical group 12, then one more sector without flushing its status.  */
+    for (i = 3072; i < 3077; i++)
+    {
+        buffer[0] = i;
+        status += lx_nand_flash_sector_write(&nand_sim_flash, i, buffer);
+    }
+    buffer[0] = 3077;
+    status += _lx_nand_flash_logical_group_write(&nand_sim_flash, 3077, (UCHAR *) buffer, 1);
+
+    /* Drop the pending updates and the anchor blocks to simulate a power loss while the anchor is mounted.  */
+    memset(nand_sim_flash.lx_nand_flash_block_status_dirty_pages, 0, sizeof(nand_sim_flash.lx_nand_flash_block_status_dirty_pages));
+    memset(nand_sim_flash.lx_nand_flash_erase_count_dirty_pages, 0, sizeof(nand_sim_flash.lx_nand_flash_erase_count_dirty_pages));
+#ifdef LX_NAND_ENABLE_METADATA_DELTA
+    nand_sim_flash.lx_nand_flash_metadata_delta_count = 0;
+#endif
+#ifndef LX_NAND_DISABLE_FAST_MOUNT
+    memset(nand_sim_flash.lx_nand_flash_anchor_block, 0xFF, sizeof(nand_sim_flash.lx_nand_flash_anchor_block));
+#endif
+    status += lx_nand_flash_close(&nand_sim_flash);
+
+    /* Reopen, the metadata is found through the anchor and the mapped blocks are verified.  */
+    status += lx_nand_flash_open(&nand_sim_flash, "sim nand flash", _lx_nand_flash_simulator_initialize, nand_memory_space, sizeof(nand_memory_space));
+    sector = nand_sim_flash.lx_nand_flash_block_mapping_table[12];
+
+    if ((status != LX_SUCCESS) ||
+        (nand_sim_flash.lx_nand_flash_block_status_table[sector] != (LX_NAND_BLOCK_STATUS_ALLOCATED | 6))
+#ifndef LX_NAND_DISABLE_FAST_MOUNT
+        || (nand_sim_flash.lx_nand_flash_diagnostic_block_status_gets > LX_NAND_ANCHOR_BLOCKS)
+#endif
+        )
+    {
+        printf("FAILED!\n");
+#ifdef BATCH_TEST
+        exit(1);
+#endif
+        while (1)
+        {
+        }
+    }
+
+#ifndef LX_NAND_DISABLE_FAST_MOUNT
+
+    /* Write a stale anchor that points at a data block, then simulate a power loss.  */
+    sector = nand_sim_flash.lx_nand_flash_metadata_block_number;
+    nand_sim_flash.lx_nand_flash_metadata_block_number = nand_sim_flash.lx_nand_flash_block_mapping_table[12];
+    status += _lx_nand_flash_anchor_write(&nand_sim_flash, LX_NAND_ANCHOR_STATE_CLEAN);
+    nand_sim_flash.lx_nand_flash_metadata_block_number = sector;
+    memset(nand_sim_flash.lx_nand_flash_anchor_block, 0xFF, sizeof(nand_sim_flash.lx_nand_flash_anchor_block));
+    status += lx_nand_flash_close(&nand_sim_flash);
+
+    /* Reopen, the stale anchor is rejected and the metadata is found by the scan.  */
+    status += lx_nand_flash_open(&nand_sim_flash, "sim nand flash", _lx_nand_flash_simulator_initialize, nand_memory_space, sizeof(nand_memory_space));
+
+    if ((status != LX_SUCCESS) || (nand_sim_flash.lx_nand_flash_metadata_block_number != sector) ||
+        (nand_sim_flash.lx_nand_flash_diagnostic_block_status_gets <= LX_NAND_ANCHOR_BLOCKS) ||
+        (nand_sim_flash.lx_nand_flash_anchor.lx_nand_anchor_metadata_block_number != sector))
+    {
+        printf("FAILED!\n");
+#ifdef BATCH_TEST
+        exit(1);
+#endif
+        while (1)
+        {
+        }
+    }
+
+    /* Free the anchor blocks to simulate a flash formatted without the fast mount, the blocks are allocated next.  */
+    for (i = 0; i < LX_NAND_ANCHOR_BLOCKS; i++)
+    {
+        j = nand_sim_flash.lx_nand_flash_anchor_block[i];
+        nand_sim_flash.lx_nand_flash_anchor_block[i] = LX_NAND_BLOCK_UNMAPPED;
+        status += _lx_nand_flash_driver_block_erase(&nand_sim_flash, j, 0);
+        status += _lx_nand_flash_block_status_set(&nand_sim_flash, j, LX_NAND_BLOCK_STATUS_FREE);
+        status += _lx_nand_flash_free_block_list_add(&nand_sim_flash, j);
+    }
+
+    /* Write logical groups to the freed blocks.  */
+    for (i = 16; i < 16 + LX_NAND_ANCHOR_BLOCKS; i++)
+    {
+        buffer[0] = i;
+        status += lx_nand_flash_sector_write(&nand_sim_flash, i * 256, buffer);
+    }
+
+    /* Reopen, the metadata is found by the scan.  */
+    status += lx_nand_flash_close(&nand_sim_flash);
+    status += lx_nand_flash_open(&nand_sim_flash, "sim nand flash", _lx_nand_flash_simulator_initialize, nand_memory_space, sizeof(nand_memory_space));
+
+    if ((status != LX_SUCCESS) || (nand_sim_flash.lx_nand_flash_metadata_block_number != sector) ||
+        (nand_sim_flash.lx_nand_flash_diagnostic_block_status_gets <= LX_NAND_ANCHOR_BLOCKS) ||
+        (nand_sim_flash.lx_nand_flash_anchor_block[0] != LX_NAND_BLOCK_UNMAPPED) ||
+        (nand_sim_flash.lx_nand_flash_block_status_table[0] != (LX_NAND_BLOCK_STATUS_ALLOCATED | 1)) ||
+        (nand_sim_flash.lx_nand_flash_block_status_table[1] != (LX_NAND_BLOCK_STATUS_ALLOCATED | 1)))
+    {
+        printf("FAILED!\n");
+#ifdef BATCH_TEST
+        exit(1);
+#endif
+        while (1)
+        {
+        }
+    }
+
+    /* Read back the logical groups.  */
+    for (i = 16; i < 16 + LX_NAND_ANCHOR_BLOCKS; i++)
+    {
+        status = lx_nand_flash_sector_read(&nand_sim_flash, i * 256, readbuffer);
+
+        if ((status != LX_SUCCESS) || (readbuffer[0] != i))
+        {
+            printf("FAILED!\n");
+#ifdef BATCH_TEST
+            exit(1);
+#endif
+            while (1)
+            {
+            }
+        }
+    }
+#endif
+
+    status = lx_nand_flash_close(&nand_sim_flash);
+
+    /* Check that no anchor is written to the first two blocks.  */
+    for (i = 0; i < 2; i++)
+    {
+        for (j = 0; j < nand_sim_flash.lx_nand_flash_pages_per_block; j++)
+        {
+#ifdef LX_NAND_ENABLE_CONTROL_BLOCK_FOR_DRIVER_INTERFACE
+            status += (nand_sim_flash.lx_nand_flash_driver_pages_read)(&nand_sim_flash, i, j, (UCHAR *) readbuffer, byte_buffer, 1);
+#else
+            status += (nand_sim_flash.lx_nand_flash_driver_pages_read)(i, j, (UCHAR *) readbuffer, byte_buffer, 1);
+#endif
+            if ((LX_UTILITY_LONG_GET(&byte_buffer[nand_sim_flash.lx_nand_flash_spare_data1_offset]) & ~LX_NAND_PAGE_TYPE_USER_DATA_MASK) == LX_NAND_PAGE_TYPE_ANCHOR)
+            {
+                status++;
+            }
+        }
+    }
+
+    if (status != LX_SUCCESS)
+    {
+        printf("FAILED!\n");
+#ifdef BATCH_TEST
+        exit(1);
+#endif
+        while (1)
+        {
+        }
+    }
+    printf("SUCCESS!\n");
+
 #if 0
     /* Point at the simulated NOR flash memory.  */
     word_ptr =  nand_flash_memory;